@@ -0,0 +1,200 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+
+
+#include "baselines.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+
+
+
+namespace  bench {
+
+static
+bool
+isWithinTolerance_( const d7cA::Point<double>&  p1,
+                    const d7cA::Point<double>&  p2,
+                    const double&               tolerance
+                  ) noexcept
+{
+  return  tolerance >= std::abs( p1.x1() - p2.x1() )
+       && tolerance >= std::abs( p1.x2() - p2.x2() )
+       && tolerance >= std::abs( p1.x3() - p2.x3() )
+       && tolerance >= std::abs( p1.x4() - p2.x4() );
+}
+
+
+static
+double
+coordinate_( const d7cA::Point<double>&  p, const unsigned&  axis ) noexcept
+{
+  switch ( axis )
+  {
+    case 0:  return  p.x1();
+    case 1:  return  p.x2();
+    case 2:  return  p.x3();
+    default: return  p.x4();
+  }
+}
+
+
+const d7cA::Point<double> *
+findSorted( const d7cA::Point<double>  *arrPoints,
+            const std::size_t&         numPoints,
+            const d7cA::Point<double>& p,
+            const double&              tolerance
+          ) noexcept
+{
+  const double  x1Min  =  p.x1() - tolerance;
+  const double  x1Max  =  p.x1() + tolerance;
+  const d7cA::Point<double> * const  pEnd  =  arrPoints + numPoints;
+  const d7cA::Point<double>  *pCur  =  std::lower_bound( arrPoints, pEnd, x1Min,
+                                                         []( const d7cA::Point<double>&  a, const double&  x1 ) { return  a.x1() < x1; } );
+  for ( ; pCur != pEnd && pCur->x1() <= x1Max; ++pCur )
+    if ( true == isWithinTolerance_( *pCur, p, tolerance ) )
+      return  pCur;
+  return  nullptr;
+}
+
+
+SoaPoints::SoaPoints( const d7cA::Point<double>  *arrPoints,
+                      const std::size_t&         numPoints
+                    )
+{
+  for ( std::vector<double>&  x : x_ )
+    x.resize( numPoints );
+  for ( std::size_t  i = 0; i < numPoints; ++i )
+  {
+    x_[ 0 ][ i ]  =  arrPoints[ i ].x1();
+    x_[ 1 ][ i ]  =  arrPoints[ i ].x2();
+    x_[ 2 ][ i ]  =  arrPoints[ i ].x3();
+    x_[ 3 ][ i ]  =  arrPoints[ i ].x4();
+  }
+}
+
+
+std::size_t
+SoaPoints::find( const d7cA::Point<double>&  p,
+                 const double&               tolerance
+               ) const noexcept
+{
+  const std::size_t  numPoints  =  x_[ 0 ].size();
+  const double * const  x1  =  x_[ 0 ].data();
+  const double * const  x2  =  x_[ 1 ].data();
+  const double * const  x3  =  x_[ 2 ].data();
+  const double * const  x4  =  x_[ 3 ].data();
+  std::size_t  i  =  0;
+#if defined( __SSE2__ )
+  // |x - q| is x - q with its sign bit cleared:
+  const __m128d  signBit  =  _mm_set1_pd( -0.0 );
+  const __m128d  tol  =  _mm_set1_pd( tolerance );
+  const __m128d  q1  =  _mm_set1_pd( p.x1() );
+  const __m128d  q2  =  _mm_set1_pd( p.x2() );
+  const __m128d  q3  =  _mm_set1_pd( p.x3() );
+  const __m128d  q4  =  _mm_set1_pd( p.x4() );
+  // most points are rejected by x1 alone, so four of them are compared
+  // along x1 first and along the other coordinates only if some of them pass:
+  for ( ; i + 4 <= numPoints; i += 4 )
+  {
+    const __m128d  isInA  =  _mm_cmple_pd( _mm_andnot_pd( signBit, _mm_sub_pd( _mm_loadu_pd( x1 + i ), q1 ) ), tol );
+    const __m128d  isInB  =  _mm_cmple_pd( _mm_andnot_pd( signBit, _mm_sub_pd( _mm_loadu_pd( x1 + i + 2 ), q1 ) ), tol );
+    if ( 0 == _mm_movemask_pd( _mm_or_pd( isInA, isInB ) ) )
+      continue;
+    for ( std::size_t  j = i; j < i + 4; j += 2 )
+    {
+      __m128d  isIn  =  ( j == i ) ? isInA : isInB;
+      isIn  =  _mm_and_pd( isIn, _mm_cmple_pd( _mm_andnot_pd( signBit, _mm_sub_pd( _mm_loadu_pd( x2 + j ), q2 ) ), tol ) );
+      isIn  =  _mm_and_pd( isIn, _mm_cmple_pd( _mm_andnot_pd( signBit, _mm_sub_pd( _mm_loadu_pd( x3 + j ), q3 ) ), tol ) );
+      isIn  =  _mm_and_pd( isIn, _mm_cmple_pd( _mm_andnot_pd( signBit, _mm_sub_pd( _mm_loadu_pd( x4 + j ), q4 ) ), tol ) );
+      const int  mask  =  _mm_movemask_pd( isIn );
+      if ( 0 != mask )
+        return  ( 0 != ( mask & 1 ) ) ? j : j + 1;
+    }
+  }
+#endif
+  // the points left over by SSE2 or all of them:
+  for ( ; i < numPoints; ++i )
+    if ( tolerance >= std::abs( x1[ i ] - p.x1() )
+      && tolerance >= std::abs( x2[ i ] - p.x2() )
+      && tolerance >= std::abs( x3[ i ] - p.x3() )
+      && tolerance >= std::abs( x4[ i ] - p.x4() )
+       )
+      return  i;
+  return  numPoints;
+}
+
+
+KdTree::KdTree( const d7cA::Point<double>  *arrPoints,
+                const std::size_t&         numPoints
+              ) : points_( arrPoints, arrPoints + numPoints )
+{
+  build_( 0, numPoints, 0 );
+}
+
+
+void
+KdTree::build_( const std::size_t&  iBegin,
+                const std::size_t&  iEnd,
+                const unsigned&     axis
+              )
+{
+  if ( iEnd - iBegin <= 1 )
+    return;
+  const std::size_t  iMid  =  iBegin + ( iEnd - iBegin ) / 2;
+  std::nth_element( points_.begin() + iBegin, points_.begin() + iMid, points_.begin() + iEnd,
+                    [ &axis ]( const d7cA::Point<double>&  a, const d7cA::Point<double>&  b ) { return  coordinate_( a, axis ) < coordinate_( b, axis ); } );
+  const unsigned  axisNext  =  ( axis + 1 ) % 4;
+  build_( iBegin, iMid, axisNext );
+  build_( iMid + 1, iEnd, axisNext );
+}
+
+
+const d7cA::Point<double> *
+KdTree::find( const d7cA::Point<double>&  p,
+              const double&               tolerance
+            ) const noexcept
+{
+  return  find_( 0, points_.size(), 0, p, tolerance );
+}
+
+
+const d7cA::Point<double> *
+KdTree::find_( const std::size_t&          iBegin,
+               const std::size_t&          iEnd,
+               const unsigned&             axis,
+               const d7cA::Point<double>&  p,
+               const double&               tolerance
+             ) const noexcept
+{
+  if ( iBegin >= iEnd )
+    return  nullptr;
+  const std::size_t  iMid  =  iBegin + ( iEnd - iBegin ) / 2;
+  const d7cA::Point<double>&  median  =  points_[ iMid ];
+  if ( true == isWithinTolerance_( median, p, tolerance ) )
+    return  &median;
+  // the ranges before and after the median hold the values
+  // not greater and not less than the median along 'axis':
+  const double  x  =  coordinate_( p, axis );
+  const double  xMedian  =  coordinate_( median, axis );
+  const unsigned  axisNext  =  ( axis + 1 ) % 4;
+  if ( x - tolerance <= xMedian )
+  {
+    const d7cA::Point<double> * const  pFound  =  find_( iBegin, iMid, axisNext, p, tolerance );
+    if ( nullptr != pFound )
+      return  pFound;
+  }
+  if ( x + tolerance >= xMedian )
+    return  find_( iMid + 1, iEnd, axisNext, p, tolerance );
+  return  nullptr;
+}
+
+} // namespace bench
@@ -0,0 +1,75 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+// the searches the Octree is compared with, besides std::find_if and std::search
+
+
+#ifndef  OCTREE_DIDACTIC_BENCHMARK_BASELINES_HPP
+#define  OCTREE_DIDACTIC_BENCHMARK_BASELINES_HPP
+
+#include "octree.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace  bench {
+
+// the first of the points sorted in the 'comparePoints' order
+// within the tolerance of 'p' ( or nullptr ):
+// a binary search of the lowest x1 within the tolerance
+// followed by a scan of the points up to the highest one:
+const d7cA::Point<double> *  findSorted( const d7cA::Point<double>  *arrPoints,
+                                         const std::size_t&         numPoints,
+                                         const d7cA::Point<double>& p,
+                                         const double&              tolerance
+                                       ) noexcept;
+
+// the coordinates of the points in four separate arrays ( SoA ),
+// scanned by SSE2 two points at a time where available:
+class  SoaPoints {
+  public:
+    SoaPoints( const d7cA::Point<double>  *arrPoints,
+               const std::size_t&         numPoints
+             );
+    // the index of the first point within the tolerance of 'p'
+    // ( or the number of points ):
+    std::size_t  find( const d7cA::Point<double>&  p,
+                       const double&               tolerance
+                     ) const noexcept;
+  private:
+    std::vector<double>  x_[ 4 ];
+};
+
+// a 4D kd-tree over a copy of the points: the median of every range
+// along the axis of its depth ( x1, x2, x3, x4, x1, ... ) is stored
+// in the middle of the range, the smaller values before it:
+class  KdTree {
+  public:
+    KdTree( const d7cA::Point<double>  *arrPoints,
+            const std::size_t&         numPoints
+          );
+    // some point within the tolerance of 'p' ( or nullptr ):
+    const d7cA::Point<double> *  find( const d7cA::Point<double>&  p,
+                                       const double&               tolerance
+                                     ) const noexcept;
+  private:
+    void  build_( const std::size_t&  iBegin,
+                  const std::size_t&  iEnd,
+                  const unsigned&     axis
+                );
+    const d7cA::Point<double> *  find_( const std::size_t&          iBegin,
+                                        const std::size_t&          iEnd,
+                                        const unsigned&             axis,
+                                        const d7cA::Point<double>&  p,
+                                        const double&               tolerance
+                                      ) const noexcept;
+  private:
+    std::vector<d7cA::Point<double> >  points_;
+};
+
+} // namespace bench
+
+#endif // OCTREE_DIDACTIC_BENCHMARK_BASELINES_HPP
@@ -0,0 +1,368 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+// the suites of the life cycle of a tree:
+// Octree::init(), Octree::insert(), ~Octree() and the memory held by a tree
+
+
+#include "baselines.hpp"
+#include "memory.hpp"
+#include "quantizedOctree.hpp"
+#include "suites.hpp"
+#include "timing.hpp"
+#include "workload.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+
+
+namespace  {
+
+typedef  d7cA::Octree<d7cA::Point, double>  Octree_;
+typedef  d7cA::QuantizedOctree<d7cA::Point, double>  OctreeInt16_;
+
+
+// the inserts of the points of an array into a tree in the order of the array:
+template<template<class> class  H, class  T>
+struct  Insert_ {
+  Insert_( d7cA::Octree<H, T>&  octree,
+           const H<T> * const   arrPoints
+         ) : octree( octree ),
+             arrPoints( arrPoints )
+  { }
+  void  prepare( const std::size_t& ) noexcept { }
+  void  operator()( const std::size_t&  i ) noexcept
+  {
+    octree.insert( arrPoints[ i ] );
+  }
+  d7cA::Octree<H, T>&  octree;
+  const H<T>           *arrPoints;
+};
+
+
+// reorders 'vec' so that every point extends the sorted order at one of its ends:
+// the points are sorted, the first one is the median, and every next one is
+// the nearest one left below or above those taken, either side at random;
+// Octree::insert() attaches every point of such an order to an end of the
+// North-South chain, while it drops most of the points of a shuffled input:
+template<class  P>
+static
+void
+orderFromTheMiddle_( std::vector<P>&  vec,
+                     bool  (*comparePoints)( const P&, const P& ),
+                     std::mt19937&    gen
+                   )
+{
+  std::sort( vec.begin(), vec.end(), comparePoints );
+  std::vector<P>  vecOut;
+  vecOut.reserve( vec.size() );
+  std::bernoulli_distribution  isUpper( 0.5 );
+  std::size_t  iLower  =  vec.size() / 2;
+  std::size_t  iUpper  =  vec.size() / 2;
+  while ( 0 < iLower
+       || vec.size() > iUpper
+        )
+  {
+    if ( vec.size() > iUpper
+      && ( 0 == iLower || true == isUpper( gen ) )
+       )
+      vecOut.push_back( vec[ iUpper++ ] );
+    else
+      vecOut.push_back( vec[ --iLower ] );
+  }
+  vec.swap( vecOut );
+}
+
+
+// the inserts of the points of 'vecInput' quantized to 16 bits over their bounding box
+// into the tree of the elements H<std::int16_t> in the order of orderFromTheMiddle_()
+// ( the quantized points are ordered, since the quantization may tie them ),
+// returns the number of the elements stored:
+template<template<class> class  H>
+static
+std::size_t
+timeInsertInt16_( const bench::Options&                     options,
+                  const std::vector<d7cA::Point<double> >&  vecInput,
+                  std::mt19937&                             gen,
+                  std::vector<double>&                      samples
+                )
+{
+  const std::size_t  numPoints  =  vecInput.size();
+  double  lo[ 4 ];
+  double  hi[ 4 ];
+  bench::boundingBox( vecInput.data(), numPoints, lo, hi );
+  const OctreeInt16_  quantizer( lo, hi );
+  std::vector<d7cA::Point<std::int16_t> >  vecOrdered;
+  vecOrdered.reserve( numPoints );
+  for ( const d7cA::Point<double>&  p : vecInput )
+    vecOrdered.push_back( quantizer.quantize( p ) );
+  orderFromTheMiddle_( vecOrdered, d7cA::comparePoints<std::int16_t>, gen );
+  std::vector<H<std::int16_t> >  vecQuantized;
+  vecQuantized.reserve( numPoints );
+  for ( const d7cA::Point<std::int16_t>&  q : vecOrdered )
+    vecQuantized.push_back( H<std::int16_t>( q.x1(), q.x2(), q.x3(), q.x4() ) );
+  d7cA::Octree<H, std::int16_t>  octree;
+  Insert_<H, std::int16_t>  insert( octree, vecQuantized.data() );
+  bench::timeBatches( insert, numPoints, options.batchSize, samples );
+  return  octree.getNumElements();
+}
+
+
+static
+double
+nanoseconds_( const bench::Clock::time_point&  start, const bench::Clock::time_point&  end ) noexcept
+{
+  return  std::chrono::duration<double, std::nano>( end - start ).count();
+}
+
+
+// the row of the time per point ( or per node ) of the samples:
+static
+bench::Row
+makeRow_( const bench::Options&  options,
+          const char * const     suite,
+          const char * const     variant,
+          const std::size_t&     numPoints,
+          const std::size_t&     batchSize,
+          std::vector<double>&   samples
+        )
+{
+  const bench::Latency  latency  =  bench::summarize( samples );
+  bench::Row  row;
+  row.set( "suite", std::string( suite ) )
+     .set( "variant", std::string( variant ) )
+     .set( "distribution", options.distribution )
+     .set( "num_points", numPoints )
+     .set( "num_runs", options.numRuns )
+     .set( "num_queries", numPoints )
+     .set( "batch_size", batchSize )
+     .set( "num_warmups", 0 )
+     .set( "points_per_s", 1e9 / latency.mean );
+  bench::setLatency( row, latency );
+  return  row;
+}
+
+} // namespace
+
+
+
+void
+bench::runBuild( const bench::Options&  options,
+                 const std::size_t&     numPoints,
+                 bench::Report&         report
+               ) noexcept
+{
+  std::mt19937  gen;
+  bench::seedGenerator( gen, options, numPoints );
+
+  // Octree::init() sorts its input, which is either shuffled or sorted already;
+  // 'std_sort' and 'kd_tree' prepare the baselines of the 'find' suite:
+  constexpr std::size_t  numVariants  =  4;
+  const char * const  variants[ numVariants ]  =  { "init_unsorted", "init_sorted", "std_sort", "kd_tree" };
+  std::vector<double>  vecSamples[ numVariants ];
+
+  std::vector<d7cA::Point<double> >  vecPoints( numPoints );
+  std::vector<d7cA::Point<double> >  vecInput( numPoints );
+  for ( std::size_t  iRun = 0; iRun < options.numRuns; ++iRun )
+  {
+    bench::generatePoints( options.distribution, gen, vecPoints.data(), numPoints );
+    for ( std::size_t  iVariant = 0; iVariant < numVariants; ++iVariant )
+    {
+      vecInput  =  vecPoints;
+      if ( 1 == iVariant )
+        std::sort( vecInput.begin(), vecInput.end(), d7cA::comparePoints<double> );
+      // the trees are destroyed outside of the timed region:
+      Octree_ * const  pOctree  =  new Octree_;
+      bench::KdTree  *pKdTree  =  nullptr;
+      const bench::Clock::time_point  start  =  bench::Clock::now();
+      if ( 2 == iVariant )
+        std::sort( vecInput.begin(), vecInput.end(), d7cA::comparePoints<double> );
+      else
+      if ( 3 == iVariant )
+        pKdTree  =  new bench::KdTree( vecInput.data(), numPoints );
+      else
+        pOctree->init( vecInput.data(), numPoints, d7cA::comparePoints<double> );
+      const bench::Clock::time_point  end  =  bench::Clock::now();
+      vecSamples[ iVariant ].push_back( nanoseconds_( start, end ) / numPoints );
+      delete  pKdTree;
+      delete  pOctree;
+    }
+  }
+
+  for ( std::size_t  iVariant = 0; iVariant < numVariants; ++iVariant )
+    report.write( makeRow_( options, "build", variants[ iVariant ], numPoints, numPoints, vecSamples[ iVariant ] ) );
+}
+
+
+void
+bench::runInsert( const bench::Options&  options,
+                  const std::size_t&     numPoints,
+                  bench::Report&         report
+                ) noexcept
+{
+  std::mt19937  gen;
+  bench::seedGenerator( gen, options, numPoints );
+
+  // 'random_ends' inserts the points in a random order in which every point
+  // extends the North-South chain at one of its ends ( see orderFromTheMiddle_() ),
+  // 'time_ordered' in the ascending order of x1 ( the order of the 'comparePoints' ),
+  // 'random_ends_int16' and 'random_ends_packed' insert the points quantized
+  // to 16 bits as Point and as PackedPoint in the order of 'random_ends'; all of
+  // these trees keep every point ( the root stays where the first point is, so every
+  // insert walks the chain from there and the time per point grows with the size );
+  // 'random_dropped' inserts the points as generated,
+  // Octree::insert() drops a point no chain end can take ( most of such an input ),
+  // so it times mostly the walks of the rejected inserts; 'num_stored' tells
+  // the elements kept and 'ns_per_stored' the time per kept one:
+  constexpr std::size_t  numVariants  =  5;
+  const char * const  variants[ numVariants ]  =  { "random_ends", "time_ordered", "random_ends_int16", "random_ends_packed", "random_dropped" };
+  std::vector<double>  vecSamples[ numVariants ];
+  std::size_t  numStored[ numVariants ]  =  { };
+
+  std::vector<d7cA::Point<double> >  vecPoints( numPoints );
+  std::vector<d7cA::Point<double> >  vecInput( numPoints );
+  for ( std::size_t  iRun = 0; iRun < options.numRuns; ++iRun )
+  {
+    bench::generatePoints( options.distribution, gen, vecPoints.data(), numPoints );
+    for ( std::size_t  iVariant = 0; iVariant < numVariants; ++iVariant )
+    {
+      vecInput  =  vecPoints;
+      if ( 0 == iVariant )
+        orderFromTheMiddle_( vecInput, d7cA::comparePoints<double>, gen );
+      if ( 1 == iVariant )
+        std::sort( vecInput.begin(), vecInput.end(), d7cA::comparePoints<double> );
+      if ( 2 == iVariant )
+      {
+        numStored[ iVariant ]  +=  timeInsertInt16_<d7cA::Point>( options, vecInput, gen, vecSamples[ iVariant ] );
+        continue;
+      }
+      if ( 3 == iVariant )
+      {
+        numStored[ iVariant ]  +=  timeInsertInt16_<d7cA::PackedPoint>( options, vecInput, gen, vecSamples[ iVariant ] );
+        continue;
+      }
+      Octree_  octree;
+      Insert_<d7cA::Point, double>  insert( octree, vecInput.data() );
+      bench::timeBatches( insert, numPoints, options.batchSize, vecSamples[ iVariant ] );
+      numStored[ iVariant ]  +=  octree.getNumElements();
+    }
+  }
+
+  for ( std::size_t  iVariant = 0; iVariant < numVariants; ++iVariant )
+  {
+    const double  meanStored  =  static_cast<double>( numStored[ iVariant ] ) / options.numRuns;
+    const double  meanNs  =  bench::summarize( vecSamples[ iVariant ] ).mean;
+    bench::Row  row  =  makeRow_( options, "insert", variants[ iVariant ], numPoints, options.batchSize, vecSamples[ iVariant ] );
+    row.set( "num_stored", meanStored );
+    if ( 0 < meanStored )
+      row.set( "ns_per_stored", meanNs * numPoints / meanStored );
+    report.write( row );
+  }
+}
+
+
+void
+bench::runDestroy( const bench::Options&  options,
+                   const std::size_t&     numPoints,
+                   bench::Report&         report
+                 ) noexcept
+{
+  std::mt19937  gen;
+  bench::seedGenerator( gen, options, numPoints );
+
+  // 'init' releases the nodes one by one, 'clone' releases the single arena of a clone;
+  // the time is per node:
+  constexpr std::size_t  numVariants  =  2;
+  const char * const  variants[ numVariants ]  =  { "init", "clone" };
+  std::vector<double>  vecSamples[ numVariants ];
+
+  std::vector<d7cA::Point<double> >  vecPoints( numPoints );
+  for ( std::size_t  iRun = 0; iRun < options.numRuns; ++iRun )
+  {
+    bench::generatePoints( options.distribution, gen, vecPoints.data(), numPoints );
+    Octree_ * const  pOctree  =  new Octree_;
+    pOctree->init( vecPoints.data(), numPoints, d7cA::comparePoints<double> );
+    Octree_ * const  pClone  =  new Octree_( pOctree->clone() );
+
+    Octree_ * const  aTrees[ numVariants ]  =  { pOctree, pClone };
+    for ( std::size_t  iVariant = 0; iVariant < numVariants; ++iVariant )
+    {
+      const std::size_t  numNodes  =  aTrees[ iVariant ]->getNumNodes();
+      const bench::Clock::time_point  start  =  bench::Clock::now();
+      delete  aTrees[ iVariant ];
+      const bench::Clock::time_point  end  =  bench::Clock::now();
+      vecSamples[ iVariant ].push_back( nanoseconds_( start, end ) / std::max<std::size_t>( 1, numNodes ) );
+    }
+  }
+
+  for ( std::size_t  iVariant = 0; iVariant < numVariants; ++iVariant )
+    report.write( makeRow_( options, "destroy", variants[ iVariant ], numPoints, numPoints, vecSamples[ iVariant ] ) );
+}
+
+
+void
+bench::runMemory( const bench::Options&  options,
+                  const std::size_t&     numPoints,
+                  bench::Report&         report
+                ) noexcept
+{
+  std::mt19937  gen;
+  bench::seedGenerator( gen, options, numPoints );
+
+  // 'init_int16' holds the coordinates quantized to 16 bits
+  // over the bounding box of the points ( see QuantizedOctree ):
+  constexpr std::size_t  numVariants  =  2;
+  const char * const  variants[ numVariants ]  =  { "init", "init_int16" };
+
+  std::vector<d7cA::Point<double> >  vecPoints( numPoints );
+  // the memory freed by a run may be reused by the next one,
+  // so the largest growth of the resident set over the runs is reported:
+  std::size_t  rssGrowth[ numVariants ]  =  { };
+  std::size_t  numTreeBytes[ numVariants ]  =  { };
+  for ( std::size_t  iRun = 0; iRun < options.numRuns; ++iRun )
+  {
+    bench::generatePoints( options.distribution, gen, vecPoints.data(), numPoints );
+    std::size_t  rssBefore  =  bench::currentRss();
+    Octree_ * const  pOctree  =  new Octree_;
+    pOctree->init( vecPoints.data(), numPoints, d7cA::comparePoints<double> );
+    std::size_t  rssAfter  =  bench::currentRss();
+    rssGrowth[ 0 ]  =  std::max( rssGrowth[ 0 ], ( rssAfter > rssBefore ) ? rssAfter - rssBefore : 0 );
+    numTreeBytes[ 0 ]  =  std::max<std::size_t>( numTreeBytes[ 0 ], pOctree->stats().numBytes );
+    delete  pOctree;
+
+    double  lo[ 4 ];
+    double  hi[ 4 ];
+    bench::boundingBox( vecPoints.data(), numPoints, lo, hi );
+    rssBefore  =  bench::currentRss();
+    OctreeInt16_ * const  pOctreeInt16  =  new OctreeInt16_( lo, hi );
+    pOctreeInt16->init( vecPoints.data(), numPoints, d7cA::comparePoints<std::int16_t> );
+    rssAfter  =  bench::currentRss();
+    rssGrowth[ 1 ]  =  std::max( rssGrowth[ 1 ], ( rssAfter > rssBefore ) ? rssAfter - rssBefore : 0 );
+    numTreeBytes[ 1 ]  =  std::max<std::size_t>( numTreeBytes[ 1 ], pOctreeInt16->getOctree().stats().numBytes );
+    delete  pOctreeInt16;
+  }
+
+  for ( std::size_t  iVariant = 0; iVariant < numVariants; ++iVariant )
+  {
+    bench::Row  row;
+    row.set( "suite", std::string( "memory" ) )
+       .set( "variant", std::string( variants[ iVariant ] ) )
+       .set( "distribution", options.distribution )
+       .set( "num_points", numPoints )
+       .set( "num_runs", options.numRuns )
+       .set( "rss_bytes", rssGrowth[ iVariant ] )
+       .set( "peak_rss_bytes", bench::peakRss() )
+       .set( "bytes_per_point", static_cast<double>( numTreeBytes[ iVariant ] ) / numPoints )
+       .set( "rss_bytes_per_point", static_cast<double>( rssGrowth[ iVariant ] ) / numPoints );
+    report.write( row );
+  }
+}
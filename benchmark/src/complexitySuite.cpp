@@ -0,0 +1,173 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+// the 'complexity' suite: the growth of the cost of Octree::insert(),
+// Octree::find() and ~Octree() with the number of points
+
+
+#include "suites.hpp"
+#include "timing.hpp"
+#include "workload.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+
+
+namespace  {
+
+typedef  d7cA::Octree<d7cA::Point, double>  Octree_;
+
+constexpr std::size_t  numOperations_  =  3;
+const char * const  operations_[ numOperations_ ]  =  { "insert", "find", "destroy" };
+
+
+static
+double
+nanoseconds_( const bench::Clock::time_point&  start, const bench::Clock::time_point&  end ) noexcept
+{
+  return  std::chrono::duration<double, std::nano>( end - start ).count();
+}
+
+
+// the least-squares slope of log( y ) over log( x ) ( nan for less than two sizes ):
+static
+double
+fitExponent_( const std::vector<double>&  x, const std::vector<double>&  y ) noexcept
+{
+  const std::size_t  num  =  x.size();
+  double  sumX  =  0;
+  double  sumY  =  0;
+  for ( std::size_t i = 0; i < num; ++i )
+  {
+    sumX  +=  std::log( x[ i ] );
+    sumY  +=  std::log( y[ i ] );
+  }
+  double  sumXX  =  0;
+  double  sumXY  =  0;
+  for ( std::size_t i = 0; i < num; ++i )
+  {
+    const double  dx  =  std::log( x[ i ] ) - sumX / num;
+    sumXX  +=  dx * dx;
+    sumXY  +=  dx * ( std::log( y[ i ] ) - sumY / num );
+  }
+  if ( 2 > num
+    || 0 == sumXX
+     )
+    return  std::numeric_limits<double>::quiet_NaN();
+  return  sumXY / sumXX;
+}
+
+} // namespace
+
+
+
+bool
+bench::runComplexity( const bench::Options&  options,
+                      bench::Report&         report
+                    ) noexcept
+{
+  // the total time of 'n' operations per size, for the fit:
+  std::vector<double>  vecSizes;
+  std::vector<double>  vecTotals[ numOperations_ ];
+
+  for ( const std::size_t  numPoints : options.sizes )
+  {
+    std::mt19937  gen;
+    bench::seedGenerator( gen, options, numPoints );
+    // the points are inserted in the order they are generated in,
+    // then every one of them is looked up exactly, then the tree is destroyed;
+    // Octree::insert() drops the points no chain end can take ( most of the points
+    // of a shuffled input, none of a sorted one ), so that the insert and the find
+    // rows of such an input time mostly the rejected inserts and the lookups
+    // of the points dropped: 'num_stored' tells the points kept per run
+    // and 'num_not_found' the points find() does not return per run:
+    std::vector<double>  vecSamples[ numOperations_ ];
+    std::size_t  numStored  =  0;
+    std::size_t  numNotFound  =  0;
+    std::vector<d7cA::Point<double> >  vecPoints( numPoints );
+    for ( std::size_t  iRun = 0; iRun < options.numRuns; ++iRun )
+    {
+      bench::generatePoints( options.distribution, gen, vecPoints.data(), numPoints );
+      Octree_ * const  pOctree  =  new Octree_;
+
+      bench::Clock::time_point  start  =  bench::Clock::now();
+      for ( const d7cA::Point<double>&  p : vecPoints )
+        pOctree->insert( p );
+      bench::Clock::time_point  end  =  bench::Clock::now();
+      vecSamples[ 0 ].push_back( nanoseconds_( start, end ) / numPoints );
+      numStored  +=  pOctree->getNumElements();
+
+      start  =  bench::Clock::now();
+      for ( const d7cA::Point<double>&  p : vecPoints )
+      {
+        d7cA::NoQueryStats  stats;
+        if ( nullptr == pOctree->find( p, stats ) )
+          ++numNotFound;
+      }
+      end  =  bench::Clock::now();
+      vecSamples[ 1 ].push_back( nanoseconds_( start, end ) / numPoints );
+
+      const std::size_t  numNodes  =  pOctree->getNumNodes();
+      start  =  bench::Clock::now();
+      delete  pOctree;
+      end  =  bench::Clock::now();
+      vecSamples[ 2 ].push_back( nanoseconds_( start, end ) / numNodes );
+    }
+
+    vecSizes.push_back( static_cast<double>( numPoints ) );
+    for ( std::size_t  iOperation = 0; iOperation < numOperations_; ++iOperation )
+    {
+      const bench::Latency  latency  =  bench::summarize( vecSamples[ iOperation ] );
+      vecTotals[ iOperation ].push_back( latency.mean * numPoints );
+      bench::Row  row;
+      row.set( "suite", std::string( "complexity" ) )
+         .set( "variant", std::string( operations_[ iOperation ] ) )
+         .set( "distribution", options.distribution )
+         .set( "num_points", numPoints )
+         .set( "num_runs", options.numRuns )
+         .set( "num_queries", numPoints )
+         .set( "batch_size", numPoints )
+         .set( "num_warmups", 0 );
+      if ( 0 == iOperation )
+        row.set( "num_stored", static_cast<double>( numStored ) / options.numRuns );
+      if ( 1 == iOperation )
+        row.set( "num_not_found", static_cast<double>( numNotFound ) / options.numRuns );
+      bench::setLatency( row, latency );
+      report.write( row );
+    }
+  }
+
+  // one more row per operation holds the exponent 'k' of the fit
+  // 'total time of n operations ~ n^k' over all the sizes:
+  bool  isWithinBounds  =  true;
+  for ( std::size_t  iOperation = 0; iOperation < numOperations_; ++iOperation )
+  {
+    const double  exponent  =  fitExponent_( vecSizes, vecTotals[ iOperation ] );
+    const bool  isSuperlinear  =  exponent > options.maxExponent;
+    if ( true == isSuperlinear )
+    {
+      fprintf( stderr, "%s on '%s' grows as n^%.2f ( more than n^%.2f )\n",
+               operations_[ iOperation ], options.distribution.c_str(), exponent, options.maxExponent );
+      isWithinBounds  =  false;
+    }
+    bench::Row  row;
+    row.set( "suite", std::string( "complexity" ) )
+       .set( "variant", std::string( operations_[ iOperation ] ) )
+       .set( "distribution", options.distribution )
+       .set( "num_runs", options.numRuns )
+       .set( "exponent", exponent )
+       .set( "is_superlinear", ( true == isSuperlinear ) ? 1 : 0 );
+    report.write( row );
+  }
+  return  isWithinBounds;
+}
@@ -0,0 +1,136 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+
+
+#include "counters.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if defined( __linux__ )
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+
+namespace  bench {
+
+const char * const  counterEvents[ numCounterEvents ]  =  { "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses" };
+
+
+#if defined( __linux__ )
+
+static
+std::uint64_t
+cacheMiss_( const std::uint64_t  cache ) noexcept
+{
+  return  cache
+       | ( static_cast<std::uint64_t>( PERF_COUNT_HW_CACHE_OP_READ ) << 8 )
+       | ( static_cast<std::uint64_t>( PERF_COUNT_HW_CACHE_RESULT_MISS ) << 16 );
+}
+
+
+// a disabled counter of the calling thread in user space ( -1 if not available ):
+static
+int
+openEvent_( const std::uint32_t  type, const std::uint64_t  config ) noexcept
+{
+  struct perf_event_attr  attr;
+  std::memset( &attr, 0, sizeof( attr ) );
+  attr.size  =  sizeof( attr );
+  attr.type  =  type;
+  attr.config  =  config;
+  attr.disabled  =  1;
+  attr.exclude_kernel  =  1;
+  attr.exclude_hv  =  1;
+  attr.read_format  =  PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return  static_cast<int>( syscall( __NR_perf_event_open, &attr, 0, -1, -1, 0 ) );
+}
+
+#endif
+
+
+Counters::Counters()
+{
+  for ( int&  fd : fds_ )
+    fd  =  -1;
+#if defined( __linux__ )
+  // the events are opened one by one rather than as a group,
+  // so that a missing event does not disable the others:
+  fds_[ 0 ]  =  openEvent_( PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES );
+  fds_[ 1 ]  =  openEvent_( PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS );
+  fds_[ 2 ]  =  openEvent_( PERF_TYPE_HW_CACHE, cacheMiss_( PERF_COUNT_HW_CACHE_L1D ) );
+  fds_[ 3 ]  =  openEvent_( PERF_TYPE_HW_CACHE, cacheMiss_( PERF_COUNT_HW_CACHE_LL ) );
+  fds_[ 4 ]  =  openEvent_( PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES );
+  fds_[ 5 ]  =  openEvent_( PERF_TYPE_HW_CACHE, cacheMiss_( PERF_COUNT_HW_CACHE_DTLB ) );
+#endif
+}
+
+
+Counters::~Counters()
+{
+#if defined( __linux__ )
+  for ( const int  fd : fds_ )
+    if ( 0 <= fd )
+      close( fd );
+#endif
+}
+
+
+bool
+Counters::isAvailable() const noexcept
+{
+  for ( const int  fd : fds_ )
+    if ( 0 <= fd )
+      return  true;
+  return  false;
+}
+
+
+void
+Counters::start() noexcept
+{
+#if defined( __linux__ )
+  for ( const int  fd : fds_ )
+    if ( 0 <= fd )
+    {
+      ioctl( fd, PERF_EVENT_IOC_RESET, 0 );
+      ioctl( fd, PERF_EVENT_IOC_ENABLE, 0 );
+    }
+#endif
+}
+
+
+void
+Counters::stop( Values&  values ) noexcept
+{
+#if defined( __linux__ )
+  for ( const int  fd : fds_ )
+    if ( 0 <= fd )
+      ioctl( fd, PERF_EVENT_IOC_DISABLE, 0 );
+#endif
+  for ( std::size_t  iEvent = 0; iEvent < numCounterEvents; ++iEvent )
+  {
+    double  count  =  std::numeric_limits<double>::quiet_NaN();
+#if defined( __linux__ )
+    // the count, the time enabled and the time running:
+    std::uint64_t  aRead[ 3 ]  =  { 0, 0, 0 };
+    if ( 0 <= fds_[ iEvent ]
+      && static_cast<ssize_t>( sizeof( aRead ) ) == read( fds_[ iEvent ], aRead, sizeof( aRead ) )
+      && 0 < aRead[ 2 ]
+       )
+      count  =  static_cast<double>( aRead[ 0 ] ) * aRead[ 1 ] / aRead[ 2 ];
+#endif
+    values[ iEvent ]  +=  count;
+  }
+}
+
+} // namespace bench
@@ -0,0 +1,48 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+// hardware performance counters of the benchmark ( Linux perf_event_open() )
+
+
+#ifndef  OCTREE_DIDACTIC_BENCHMARK_COUNTERS_HPP
+#define  OCTREE_DIDACTIC_BENCHMARK_COUNTERS_HPP
+
+#include <cstddef>
+
+namespace  bench {
+
+// the events counted, in the order of Counters::Values:
+// cycles, instructions, L1 data read misses, last level cache read misses,
+// branch misses, data TLB read misses:
+constexpr std::size_t  numCounterEvents  =  6;
+extern const char * const  counterEvents[ numCounterEvents ];
+
+// the events of the calling thread in user space; an event the kernel
+// or the CPU does not provide ( or any event outside of Linux ) stays unavailable
+// and its counts are nan:
+class  Counters {
+  public:
+    typedef  double  Values[ numCounterEvents ];
+  public:
+    Counters();
+    ~Counters();
+    // whether at least one of the events is counted:
+    bool  isAvailable() const noexcept;
+    // resets and starts all the events:
+    void  start() noexcept;
+    // stops all the events and adds their counts since start() to 'values'
+    // ( scaled up if the kernel multiplexed an event with others ):
+    void  stop( Values&  values ) noexcept;
+  private:
+    Counters( const Counters& );
+    Counters&  operator=( const Counters& );
+  private:
+    int  fds_[ numCounterEvents ];
+};
+
+} // namespace bench
+
+#endif // OCTREE_DIDACTIC_BENCHMARK_COUNTERS_HPP
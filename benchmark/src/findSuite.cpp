@@ -0,0 +1,481 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+// the 'find' suite: Octree::find() against the search over an array
+
+
+#include "baselines.hpp"
+#include "counters.hpp"
+#include "quantizedOctree.hpp"
+#include "suites.hpp"
+#include "timing.hpp"
+#include "workload.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+
+
+namespace  {
+
+template<class T>
+struct  Predicate_ {
+  public:
+    Predicate_( const d7cA::Point<T>&  p,
+                const T&               tolerance
+              ) : p_( p ),
+                  tolerance_( tolerance )
+    { }
+    bool  operator()( const d7cA::Point<T>&  p )
+    {
+      if ( tolerance_ >= std::abs( p.x1() - p_.x1() )
+        && tolerance_ >= std::abs( p.x2() - p_.x2() )
+        && tolerance_ >= std::abs( p.x3() - p_.x3() )
+        && tolerance_ >= std::abs( p.x4() - p_.x4() )
+         )
+      {
+        return  true;
+      }
+      return  false;
+    }
+  private:
+    d7cA::Point<T>  p_;
+    T               tolerance_;
+};
+
+
+template<class T>
+struct  PredicateSearch_ {
+  public:
+    PredicateSearch_(
+                      const T&  tolerance
+                    ) :
+                        tolerance_( tolerance )
+    { }
+    bool  operator()( const d7cA::Point<T>&  p1, const d7cA::Point<T>&  p2 )
+    {
+      if ( tolerance_ >= std::abs( p1.x1() - p2.x1() )
+        && tolerance_ >= std::abs( p1.x2() - p2.x2() )
+        && tolerance_ >= std::abs( p1.x3() - p2.x3() )
+        && tolerance_ >= std::abs( p1.x4() - p2.x4() )
+         )
+      {
+        return  true;
+      }
+      return  false;
+    }
+  private:
+    T  tolerance_;
+};
+
+
+static
+bool
+isWithinTolerance_( const d7cA::Point<double>&  p1,
+                    const d7cA::Point<double>&  p2,
+                    const double&               tolerance
+                  ) noexcept
+{
+  return  tolerance >= std::abs( p1.x1() - p2.x1() )
+       && tolerance >= std::abs( p1.x2() - p2.x2() )
+       && tolerance >= std::abs( p1.x3() - p2.x3() )
+       && tolerance >= std::abs( p1.x4() - p2.x4() );
+}
+
+
+typedef  bench::Query  Query_;
+
+typedef  std::vector<const d7cA::Point<double> *>  Results_;
+
+
+// the variants of the 'find' suite: 'variant( i )' answers the query 'i'
+// and stores the element found ( or nullptr ) into 'results[ i ]':
+struct  Variant_ {
+  Variant_( const std::vector<Query_>&  queries,
+            Results_&                   results,
+            const d7cA::Point<double>   *arrPoints,
+            const std::size_t&          numPoints
+          ) : queries( queries ),
+              results( results ),
+              arrPoints( arrPoints ),
+              numPoints( numPoints )
+  { }
+  void  prepare( const std::size_t& ) noexcept { }
+  const std::vector<Query_>&  queries;
+  Results_&                   results;
+  const d7cA::Point<double>   *arrPoints;
+  std::size_t                 numPoints;
+};
+
+
+struct  FindOctree_ : public Variant_ {
+  FindOctree_( const std::vector<Query_>&                queries,
+               Results_&                                 results,
+               const d7cA::Octree<d7cA::Point, double>&  octree
+             ) : Variant_( queries, results, nullptr, 0 ),
+                 octree( octree )
+  { }
+  void  operator()( const std::size_t&  i ) noexcept
+  {
+    std::size_t  numOperations  =  0;
+    const d7cA::OctreeObj<d7cA::Point, double> * const  result  =  octree.find( queries[ i ].p, numOperations, queries[ i ].tolerance );
+    results[ i ]  =  ( nullptr == result ) ? nullptr : &result->info;
+  }
+  const d7cA::Octree<d7cA::Point, double>&  octree;
+};
+
+
+// Octree::findBatch() over the batches of timeBatches(): the whole batch
+// is answered by the call for its first query, the calls for the others
+// only pick their results up:
+struct  FindBatched_ : public Variant_ {
+  FindBatched_( const std::vector<Query_>&                queries,
+                Results_&                                 results,
+                const d7cA::Octree<d7cA::Point, double>&  octree,
+                const std::size_t&                        batchSize
+              ) : Variant_( queries, results, nullptr, 0 ),
+                  octree( octree ),
+                  batchSize( batchSize ),
+                  points( queries.size() ),
+                  tolerances( queries.size() ),
+                  found( queries.size(), nullptr )
+  {
+    for ( std::size_t i = 0; i < queries.size(); ++i )
+    {
+      points[ i ]  =  queries[ i ].p;
+      tolerances[ i ]  =  queries[ i ].tolerance;
+    }
+  }
+  void  operator()( const std::size_t&  i ) noexcept
+  {
+    if ( 0 == i % batchSize )
+      octree.findBatch( points.data() + i, tolerances.data() + i, std::min( batchSize, points.size() - i ), found.data() + i );
+    results[ i ]  =  ( nullptr == found[ i ] ) ? nullptr : &found[ i ]->info;
+  }
+  const d7cA::Octree<d7cA::Point, double>&              octree;
+  std::size_t                                           batchSize;
+  std::vector<d7cA::Point<double> >                     points;
+  std::vector<double>                                   tolerances;
+  std::vector<d7cA::OctreeObj<d7cA::Point, double> *>  found;
+};
+
+// the element found is restored to 'found[ i ]':
+struct  FindQuantized_ : public Variant_ {
+  FindQuantized_( const std::vector<Query_>&                                 queries,
+                  Results_&                                                  results,
+                  const d7cA::QuantizedOctree<d7cA::Point, double>&          octree,
+                  std::vector<d7cA::Point<double> >&                         found
+                ) : Variant_( queries, results, nullptr, 0 ),
+                    octree( octree ),
+                    found( found )
+  { }
+  void  operator()( const std::size_t&  i ) noexcept
+  {
+    d7cA::NoQueryStats  stats;
+    const d7cA::OctreeObj<d7cA::Point, std::int16_t> * const  result  =  octree.find( queries[ i ].p, stats, queries[ i ].tolerance );
+    if ( nullptr == result )
+    {
+      results[ i ]  =  nullptr;
+      return;
+    }
+    found[ i ]  =  octree.dequantize( result->info );
+    results[ i ]  =  &found[ i ];
+  }
+  const d7cA::QuantizedOctree<d7cA::Point, double>&  octree;
+  std::vector<d7cA::Point<double> >&                 found;
+};
+
+
+struct  FindIf_ : public Variant_ {
+  FindIf_( const std::vector<Query_>&  queries,
+           Results_&                   results,
+           const d7cA::Point<double>   *arrPoints,
+           const std::size_t&          numPoints
+         ) : Variant_( queries, results, arrPoints, numPoints )
+  { }
+  void  operator()( const std::size_t&  i ) noexcept
+  {
+    const d7cA::Point<double> * const  pFound  =  std::find_if( arrPoints, arrPoints + numPoints, Predicate_<double>( queries[ i ].p, queries[ i ].tolerance ) );
+    results[ i ]  =  ( arrPoints + numPoints == pFound ) ? nullptr : pFound;
+  }
+};
+
+
+struct  Search_ : public Variant_ {
+  Search_( const std::vector<Query_>&  queries,
+           Results_&                   results,
+           const d7cA::Point<double>   *arrPoints,
+           const std::size_t&          numPoints
+         ) : Variant_( queries, results, arrPoints, numPoints )
+  { }
+  void  operator()( const std::size_t&  i ) noexcept
+  {
+    const d7cA::Point<double>  pS[ 1 ]  =  { queries[ i ].p };
+    const d7cA::Point<double> * const  pFound  =  std::search( arrPoints, arrPoints + numPoints, pS, pS + 1, PredicateSearch_<double>( queries[ i ].tolerance ) );
+    results[ i ]  =  ( arrPoints + numPoints == pFound ) ? nullptr : pFound;
+  }
+};
+
+
+// a binary search of x1 over the sorted search space followed by a scan:
+struct  LowerBound_ : public Variant_ {
+  LowerBound_( const std::vector<Query_>&  queries,
+               Results_&                   results,
+               const d7cA::Point<double>   *arrPoints,
+               const std::size_t&          numPoints
+             ) : Variant_( queries, results, arrPoints, numPoints )
+  { }
+  void  operator()( const std::size_t&  i ) noexcept
+  {
+    results[ i ]  =  bench::findSorted( arrPoints, numPoints, queries[ i ].p, queries[ i ].tolerance );
+  }
+};
+
+
+// a brute-force scan of the search space stored as SoA:
+struct  SoaScan_ : public Variant_ {
+  SoaScan_( const std::vector<Query_>&  queries,
+            Results_&                   results,
+            const d7cA::Point<double>   *arrPoints,
+            const std::size_t&          numPoints,
+            const bench::SoaPoints&     soa
+          ) : Variant_( queries, results, arrPoints, numPoints ),
+              soa( soa )
+  { }
+  void  operator()( const std::size_t&  i ) noexcept
+  {
+    const std::size_t  iFound  =  soa.find( queries[ i ].p, queries[ i ].tolerance );
+    results[ i ]  =  ( numPoints == iFound ) ? nullptr : arrPoints + iFound;
+  }
+  const bench::SoaPoints&  soa;
+};
+
+
+struct  KdTree_ : public Variant_ {
+  KdTree_( const std::vector<Query_>&  queries,
+           Results_&                   results,
+           const bench::KdTree&        kdTree
+         ) : Variant_( queries, results, nullptr, 0 ),
+             kdTree( kdTree )
+  { }
+  void  operator()( const std::size_t&  i ) noexcept
+  {
+    results[ i ]  =  kdTree.find( queries[ i ].p, queries[ i ].tolerance );
+  }
+  const bench::KdTree&  kdTree;
+};
+
+
+// warms the variant up and times all its queries;
+// with 'pCounters' the queries are run once more, untimed,
+// and the hardware counters of that pass are added to 'counts':
+template<class  V>
+static
+void
+timeVariant_( V&                         variant,
+              const bench::Options&      options,
+              const std::size_t&         batchSize,
+              std::vector<double>&       samples,
+              bench::Counters * const    pCounters,
+              bench::Counters::Values&   counts
+            ) noexcept
+{
+  const std::size_t  numQueries  =  variant.queries.size();
+  for ( std::size_t  iWarmUp = 0; iWarmUp < options.numWarmUps; ++iWarmUp )
+    for ( std::size_t  i = 0; i < numQueries; ++i )
+    {
+      variant.prepare( i );
+      variant( i );
+    }
+  bench::timeBatches( variant, numQueries, batchSize, samples );
+  if ( nullptr == pCounters )
+    return;
+  pCounters->start();
+  for ( std::size_t  i = 0; i < numQueries; ++i )
+  {
+    variant.prepare( i );
+    variant( i );
+  }
+  pCounters->stop( counts );
+}
+
+} // namespace
+
+
+
+void
+bench::runFind( const bench::Options&  options,
+                const std::size_t&     numPoints,
+                bench::Report&         report
+              ) noexcept
+{
+  std::mt19937  gen;
+  bench::seedGenerator( gen, options, numPoints );
+
+  // 'find_if' and 'search' scan the search space sorted in the 'comparePoints' order,
+  // '*_unsorted' scan it in the order it was generated in;
+  // the sort, the SoA copy and the kd-tree are prepared outside of the timed region
+  // ( the 'build' suite times them ):
+  constexpr std::size_t  numVariants  =  13;
+  const char * const  variants[ numVariants ]  =  { "octree", "find_if", "search", "find_if_unsorted", "search_unsorted",
+                                                    "lower_bound", "soa_scan", "kd_tree", "octree_int16",
+                                                    "octree_depth_first", "octree_chains", "octree_batched", "octree_hash_index" };
+  std::vector<double>  vecSamples[ numVariants ];
+  std::size_t          numErrors[ numVariants ]  =  { };
+  std::size_t          numMisses  =  0;
+  // the hardware counters ( --counters ) of every variant and the nodes
+  // touched by Octree::find(), summed over the runs:
+  std::unique_ptr<bench::Counters>  pCounters;
+  bench::Counters::Values  aCounts[ numVariants ]  =  { };
+  std::size_t  numNodesTouched  =  0;
+  if ( true == options.isCounters )
+  {
+    pCounters.reset( new bench::Counters );
+    static bool  isWarned  =  false;
+    if ( false == pCounters->isAvailable()
+      && false == isWarned
+       )
+    {
+      fprintf( stderr, "the hardware counters are not available\n" );
+      isWarned  =  true;
+    }
+  }
+  Results_             vecResults[ numVariants ];
+  for ( Results_&  v : vecResults )
+    v.assign( numPoints, nullptr );
+
+  std::vector<d7cA::Point<double> >  vecPoints( numPoints );
+  std::vector<d7cA::Point<double> >  vecPointsInit( numPoints );
+  std::vector<Query_>                vecQueries( numPoints );
+  std::vector<d7cA::Point<double> >  vecFoundQuantized( numPoints );
+  d7cA::Point<double> * const  arrPoints  =  vecPoints.data();
+
+  for ( std::size_t  iRun = 0; iRun < options.numRuns; ++iRun )
+  {
+    bench::generatePoints( options.distribution, gen, arrPoints, numPoints );
+    vecPointsInit  =  vecPoints;
+
+    std::sort( arrPoints, arrPoints + numPoints, d7cA::comparePoints<double> );
+
+    d7cA::Octree<d7cA::Point, double>  octree;
+    octree.init( arrPoints, numPoints, d7cA::comparePoints<double> );
+    const bench::SoaPoints  soa( arrPoints, numPoints );
+    const bench::KdTree     kdTree( arrPoints, numPoints );
+    double  lo[ 4 ];
+    double  hi[ 4 ];
+    bench::boundingBox( arrPoints, numPoints, lo, hi );
+    d7cA::Octree<d7cA::Point, double>  octreeDepthFirst  =  octree.clone();
+    octreeDepthFirst.relayout( d7cA::OctreeLayout::depthFirst );
+    d7cA::Octree<d7cA::Point, double>  octreeChains  =  octree.clone();
+    octreeChains.relayout( d7cA::OctreeLayout::chains );
+    d7cA::Octree<d7cA::Point, double>  octreeHashIndex  =  octree.clone();
+    octreeHashIndex.setHashIndex( true );
+    d7cA::QuantizedOctree<d7cA::Point, double>  octreeQuantized( lo, hi );
+    octreeQuantized.init( arrPoints, numPoints, d7cA::comparePoints<std::int16_t> );
+
+    bench::generateQueries( options, gen, arrPoints, numPoints, vecQueries );
+
+    FindOctree_  findOctree( vecQueries, vecResults[ 0 ], octree );
+    timeVariant_( findOctree, options, options.batchSize, vecSamples[ 0 ], pCounters.get(), aCounts[ 0 ] );
+    FindIf_  findIf( vecQueries, vecResults[ 1 ], arrPoints, numPoints );
+    timeVariant_( findIf, options, options.batchSize, vecSamples[ 1 ], pCounters.get(), aCounts[ 1 ] );
+    Search_  search( vecQueries, vecResults[ 2 ], arrPoints, numPoints );
+    timeVariant_( search, options, options.batchSize, vecSamples[ 2 ], pCounters.get(), aCounts[ 2 ] );
+    FindIf_  findIfUnsorted( vecQueries, vecResults[ 3 ], vecPointsInit.data(), numPoints );
+    timeVariant_( findIfUnsorted, options, options.batchSize, vecSamples[ 3 ], pCounters.get(), aCounts[ 3 ] );
+    Search_  searchUnsorted( vecQueries, vecResults[ 4 ], vecPointsInit.data(), numPoints );
+    timeVariant_( searchUnsorted, options, options.batchSize, vecSamples[ 4 ], pCounters.get(), aCounts[ 4 ] );
+    LowerBound_  lowerBound( vecQueries, vecResults[ 5 ], arrPoints, numPoints );
+    timeVariant_( lowerBound, options, options.batchSize, vecSamples[ 5 ], pCounters.get(), aCounts[ 5 ] );
+    SoaScan_  soaScan( vecQueries, vecResults[ 6 ], arrPoints, numPoints, soa );
+    timeVariant_( soaScan, options, options.batchSize, vecSamples[ 6 ], pCounters.get(), aCounts[ 6 ] );
+    KdTree_  kdTreeFind( vecQueries, vecResults[ 7 ], kdTree );
+    timeVariant_( kdTreeFind, options, options.batchSize, vecSamples[ 7 ], pCounters.get(), aCounts[ 7 ] );
+    FindQuantized_  findQuantized( vecQueries, vecResults[ 8 ], octreeQuantized, vecFoundQuantized );
+    timeVariant_( findQuantized, options, options.batchSize, vecSamples[ 8 ], pCounters.get(), aCounts[ 8 ] );
+    FindOctree_  findDepthFirst( vecQueries, vecResults[ 9 ], octreeDepthFirst );
+    timeVariant_( findDepthFirst, options, options.batchSize, vecSamples[ 9 ], pCounters.get(), aCounts[ 9 ] );
+    FindOctree_  findChains( vecQueries, vecResults[ 10 ], octreeChains );
+    timeVariant_( findChains, options, options.batchSize, vecSamples[ 10 ], pCounters.get(), aCounts[ 10 ] );
+    FindBatched_  findBatched( vecQueries, vecResults[ 11 ], octree, options.batchSize );
+    timeVariant_( findBatched, options, options.batchSize, vecSamples[ 11 ], pCounters.get(), aCounts[ 11 ] );
+    FindOctree_  findHashIndex( vecQueries, vecResults[ 12 ], octreeHashIndex );
+    timeVariant_( findHashIndex, options, options.batchSize, vecSamples[ 12 ], pCounters.get(), aCounts[ 12 ] );
+
+    if ( true == options.isCounters )
+      for ( const Query_&  query : vecQueries )
+      {
+        d7cA::QueryStats  stats;
+        octree.find( query.p, stats, query.tolerance );
+        numNodesTouched  +=  stats.numNodesTouched;
+      }
+
+    // 'tolerance' is applied independently to each coordinate,
+    // std::find_if is the reference of whether a match exists;
+    // 'octree_int16' may find an element up to 2 resolutions beyond the tolerance,
+    // but must not miss a match:
+    const double  slack[ numVariants ]  =  { 0, 0, 0, 0, 0, 0, 0, 0, 2 * octreeQuantized.getResolution(), 0, 0, 0, 0 };
+    for ( std::size_t i = 0; i < numPoints; ++i )
+    {
+      if ( nullptr == vecResults[ 1 ][ i ] )
+        ++numMisses;
+      for ( std::size_t  iVariant = 0; iVariant < numVariants; ++iVariant )
+      {
+        const d7cA::Point<double> * const  pFound  =  vecResults[ iVariant ][ i ];
+        const bool  isMismatch  =  ( 0 == slack[ iVariant ] )
+                                   ? ( nullptr == pFound ) != ( nullptr == vecResults[ 1 ][ i ] )
+                                   : ( nullptr == pFound && nullptr != vecResults[ 1 ][ i ] );
+        if ( ( nullptr != pFound
+            && false == isWithinTolerance_( vecQueries[ i ].p, *pFound, vecQueries[ i ].tolerance + slack[ iVariant ] ) )
+          || true == isMismatch
+           )
+          ++numErrors[ iVariant ];
+      }
+    }
+  } // for ( iRun )
+
+  for ( std::size_t  iVariant = 0; iVariant < numVariants; ++iVariant )
+  {
+    bench::Row  row;
+    row.set( "suite", std::string( "find" ) )
+       .set( "variant", std::string( variants[ iVariant ] ) )
+       .set( "distribution", options.distribution )
+       .set( "num_points", numPoints )
+       .set( "num_runs", options.numRuns )
+       .set( "num_queries", numPoints )
+       .set( "batch_size", options.batchSize )
+       .set( "num_warmups", options.numWarmUps )
+       .set( "num_errors", numErrors[ iVariant ] )
+       .set( "num_misses", numMisses );
+    const double  numQueries  =  static_cast<double>( numPoints ) * options.numRuns;
+    // only Octree::find() reports the nodes it touches,
+    // the relaid trees have the shape of the tree of 'octree'
+    // and findBatch() touches the nodes find() does
+    // ( the hash index skips them for the exact queries ):
+    const bool  isOctree  =  0 == iVariant || ( 9 <= iVariant && 11 >= iVariant );
+    if ( true == options.isCounters )
+      for ( std::size_t  iEvent = 0; iEvent < bench::numCounterEvents; ++iEvent )
+      {
+        const std::string  event( bench::counterEvents[ iEvent ] );
+        row.set( ( event + "_per_query" ).c_str(), aCounts[ iVariant ][ iEvent ] / numQueries );
+        if ( true == isOctree )
+          row.set( ( event + "_per_node" ).c_str(), aCounts[ iVariant ][ iEvent ] / numNodesTouched );
+      }
+    if ( true == options.isCounters
+      && true == isOctree
+       )
+      row.set( "nodes_per_query", numNodesTouched / numQueries );
+    bench::setLatency( row, bench::summarize( vecSamples[ iVariant ] ) );
+    report.write( row );
+  }
+}
@@ -0,0 +1,57 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+
+
+#include "memory.hpp"
+
+#include <cstdio>
+
+#if defined( __linux__ )
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+
+
+namespace  bench {
+
+std::size_t
+currentRss()
+{
+#if defined( __linux__ )
+  FILE * const  pF  =  fopen( "/proc/self/statm", "r" );
+  if ( nullptr == pF )
+    return  0;
+  // the second field is the number of resident pages:
+  unsigned long  numPagesTotal  =  0;
+  unsigned long  numPagesResident  =  0;
+  const int  numRead  =  fscanf( pF, "%lu %lu", &numPagesTotal, &numPagesResident );
+  fclose( pF );
+  if ( 2 != numRead )
+    return  0;
+  return  static_cast<std::size_t>( numPagesResident ) * static_cast<std::size_t>( sysconf( _SC_PAGESIZE ) );
+#else
+  return  0;
+#endif
+}
+
+
+std::size_t
+peakRss()
+{
+#if defined( __linux__ )
+  struct rusage  usage;
+  if ( 0 != getrusage( RUSAGE_SELF, &usage ) )
+    return  0;
+  // kilobytes on Linux:
+  return  static_cast<std::size_t>( usage.ru_maxrss ) * 1024;
+#else
+  return  0;
+#endif
+}
+
+} // namespace bench
@@ -0,0 +1,26 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+// the memory used by the benchmark process
+
+
+#ifndef  OCTREE_DIDACTIC_BENCHMARK_MEMORY_HPP
+#define  OCTREE_DIDACTIC_BENCHMARK_MEMORY_HPP
+
+#include <cstddef>
+
+namespace  bench {
+
+// the resident set size of the process in bytes ( 0 if unknown ):
+std::size_t  currentRss();
+
+// the peak resident set size of the process since its start
+// in bytes ( 0 if unknown ):
+std::size_t  peakRss();
+
+} // namespace bench
+
+#endif // OCTREE_DIDACTIC_BENCHMARK_MEMORY_HPP
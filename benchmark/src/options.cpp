@@ -0,0 +1,314 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+
+
+#include "options.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+
+
+
+namespace  bench {
+
+static const char * const  distributions_[]  =  { "grouped", "uniform", "gaussian", "trajectory", "duplicates",
+                                                    "same_x1", "sorted", "reverse_sorted", "sawtooth" };
+static const char * const  suites_[]  =  { "find", "build", "insert", "destroy", "memory", "traversal", "complexity" };
+
+
+Options::Options() : suites( 1, "find" ),
+                     sizes(),
+                     numRuns( 1000 ),
+                     seed( 1 ),
+                     distribution( "grouped" ),
+                     toleranceMin( 0 ),
+                     toleranceMax( 3 ),
+                     missRatio( -1 ),
+                     querySkew( 0 ),
+                     batchSize( 64 ),
+                     numWarmUps( 1 ),
+                     maxExponent( 1.3 ),
+                     isCounters( false ),
+                     iCpu( -1 ),
+                     format( "csv" ),
+                     output(),
+                     isHelp( false ),
+                     isSchema( false )
+{
+  // the set-up the results in README.md were obtained with:
+  for ( std::size_t  numPoints = 100; numPoints <= 5050; numPoints += 50 )
+    sizes.push_back( numPoints );
+}
+
+
+bool
+isDistribution( const std::string&  name )
+{
+  for ( const char * const  p : distributions_ )
+    if ( name == p )
+      return  true;
+  return  false;
+}
+
+
+bool
+isSuite( const std::string&  name )
+{
+  for ( const char * const  p : suites_ )
+    if ( name == p )
+      return  true;
+  return  false;
+}
+
+
+static
+bool
+parseSize_( const std::string&  in, std::size_t&  out )
+{
+  if ( true == in.empty()
+    || '-' == in[ 0 ]
+     )
+    return  false;
+  char  *pEnd  =  nullptr;
+  errno  =  0;
+  const unsigned long long  value  =  std::strtoull( in.c_str(), &pEnd, 10 );
+  if ( 0 != errno
+    || '\0' != *pEnd
+     )
+    return  false;
+  out  =  static_cast<std::size_t>( value );
+  return  true;
+}
+
+
+static
+bool
+parseDouble_( const std::string&  in, double&  out )
+{
+  if ( true == in.empty() )
+    return  false;
+  char  *pEnd  =  nullptr;
+  errno  =  0;
+  out  =  std::strtod( in.c_str(), &pEnd );
+  return  0 == errno && '\0' == *pEnd;
+}
+
+
+// "first:last:step" or a comma-separated list:
+static
+bool
+parseSizes_( const std::string&  in, std::vector<std::size_t>&  out )
+{
+  out.clear();
+  const std::size_t  iColon1  =  in.find( ':' );
+  if ( std::string::npos != iColon1 )
+  {
+    const std::size_t  iColon2  =  in.find( ':', iColon1 + 1 );
+    std::size_t  first  =  0;
+    std::size_t  last  =  0;
+    std::size_t  step  =  0;
+    if ( std::string::npos == iColon2
+      || false == parseSize_( in.substr( 0, iColon1 ), first )
+      || false == parseSize_( in.substr( iColon1 + 1, iColon2 - iColon1 - 1 ), last )
+      || false == parseSize_( in.substr( iColon2 + 1 ), step )
+      || 0 == step
+      || 0 == first
+      || first > last
+       )
+      return  false;
+    for ( std::size_t  numPoints = first; numPoints <= last; numPoints += step )
+      out.push_back( numPoints );
+    return  true;
+  }
+  std::size_t  iBegin  =  0;
+  while ( iBegin <= in.size() )
+  {
+    std::size_t  iEnd  =  in.find( ',', iBegin );
+    if ( std::string::npos == iEnd )
+      iEnd  =  in.size();
+    std::size_t  numPoints  =  0;
+    if ( false == parseSize_( in.substr( iBegin, iEnd - iBegin ), numPoints )
+      || 0 == numPoints
+       )
+      return  false;
+    out.push_back( numPoints );
+    iBegin  =  iEnd + 1;
+  }
+  return  false == out.empty();
+}
+
+
+// a comma-separated list of suites:
+static
+bool
+parseSuites_( const std::string&  in, std::vector<std::string>&  out )
+{
+  out.clear();
+  std::size_t  iBegin  =  0;
+  while ( iBegin <= in.size() )
+  {
+    std::size_t  iEnd  =  in.find( ',', iBegin );
+    if ( std::string::npos == iEnd )
+      iEnd  =  in.size();
+    const std::string  suite  =  in.substr( iBegin, iEnd - iBegin );
+    if ( false == isSuite( suite ) )
+      return  false;
+    out.push_back( suite );
+    iBegin  =  iEnd + 1;
+  }
+  return  true;
+}
+
+
+// "min:max" or a single value:
+static
+bool
+parseTolerance_( const std::string&  in, double&  min, double&  max )
+{
+  const std::size_t  iColon  =  in.find( ':' );
+  if ( std::string::npos == iColon )
+  {
+    if ( false == parseDouble_( in, min ) )
+      return  false;
+    max  =  min;
+  }
+  else
+  if ( false == parseDouble_( in.substr( 0, iColon ), min )
+    || false == parseDouble_( in.substr( iColon + 1 ), max )
+     )
+    return  false;
+  return  0 <= min && min <= max;
+}
+
+
+bool
+parseOptions( const int  argc, char * argv[], Options&  options )
+{
+  for ( int  iArg = 1; iArg < argc; ++iArg )
+  {
+    const std::string  arg( argv[ iArg ] );
+    const std::size_t  iEqual  =  arg.find( '=' );
+    const std::string  name  =  arg.substr( 0, iEqual );
+    const std::string  value  =  ( std::string::npos == iEqual ) ? std::string() : arg.substr( iEqual + 1 );
+    bool  isValid  =  true;
+    if ( "--help" == name
+      || "-h" == name
+       )
+      options.isHelp  =  true;
+    else
+    if ( "--schema" == name )
+      options.isSchema  =  true;
+    else
+    if ( "--suites" == name )
+      isValid  =  parseSuites_( value, options.suites );
+    else
+    if ( "--sizes" == name )
+      isValid  =  parseSizes_( value, options.sizes );
+    else
+    if ( "--runs" == name )
+      isValid  =  parseSize_( value, options.numRuns ) && 0 < options.numRuns;
+    else
+    if ( "--seed" == name )
+    {
+      std::size_t  seed  =  0;
+      isValid  =  parseSize_( value, seed );
+      options.seed  =  seed;
+    }
+    else
+    if ( "--distribution" == name )
+    {
+      options.distribution  =  value;
+      isValid  =  isDistribution( value );
+    }
+    else
+    if ( "--tolerance" == name )
+      isValid  =  parseTolerance_( value, options.toleranceMin, options.toleranceMax );
+    else
+    if ( "--miss-ratio" == name )
+      isValid  =  parseDouble_( value, options.missRatio ) && 0 <= options.missRatio && 1 >= options.missRatio;
+    else
+    if ( "--query-skew" == name )
+      isValid  =  parseDouble_( value, options.querySkew ) && 0 <= options.querySkew;
+    else
+    if ( "--batch" == name )
+      isValid  =  parseSize_( value, options.batchSize ) && 0 < options.batchSize;
+    else
+    if ( "--warmup" == name )
+      isValid  =  parseSize_( value, options.numWarmUps );
+    else
+    if ( "--max-exponent" == name )
+      isValid  =  parseDouble_( value, options.maxExponent ) && 0 < options.maxExponent;
+    else
+    if ( "--counters" == name )
+      options.isCounters  =  true;
+    else
+    if ( "--cpu" == name )
+    {
+      std::size_t  iCpu  =  0;
+      isValid  =  parseSize_( value, iCpu ) && 1024 > iCpu;
+      options.iCpu  =  static_cast<int>( iCpu );
+    }
+    else
+    if ( "--format" == name )
+    {
+      options.format  =  value;
+      isValid  =  ( "csv" == value || "json" == value || "tsv" == value );
+    }
+    else
+    if ( "--output" == name )
+    {
+      options.output  =  value;
+      isValid  =  false == value.empty();
+    }
+    else
+    if ( 0 != arg.compare( 0, 1, "-" ) )
+      options.output  =  arg; // the output file used to be the only argument
+    else
+      isValid  =  false;
+    if ( false == isValid )
+    {
+      fprintf( stderr, "invalid option: %s\n", arg.c_str() );
+      return  false;
+    }
+  }
+  return  true;
+}
+
+
+void
+printUsage( const char * const  program )
+{
+  fprintf( stderr,
+           "usage: %s [options] [output-file]\n"
+           "  --suites=NAME1,NAME2,...                      suites to run ( find )\n"
+           "  --sizes=FIRST:LAST:STEP | --sizes=N1,N2,...   numbers of points ( 100:5050:50 )\n"
+           "  --runs=N                                      search spaces per size ( 1000 )\n"
+           "  --seed=N                                      seed of the random input ( 1 )\n"
+           "  --distribution=NAME                           generator of the points ( grouped )\n"
+           "  --tolerance=MIN:MAX | --tolerance=VALUE       tolerance of the queries ( 0:3 )\n"
+           "  --miss-ratio=R                                share of the queries with no match\n"
+           "  --query-skew=S                                Zipf exponent of the query targets ( 0 )\n"
+           "  --batch=N                                     queries timed together ( 64 )\n"
+           "  --warmup=N                                    untimed passes over the queries ( 1 )\n"
+           "  --max-exponent=K                              complexity flagged above n^K ( 1.3 )\n"
+           "  --counters                                    read the hardware counters ( Linux only )\n"
+           "  --cpu=N                                       bind the benchmark to the CPU N\n"
+           "  --format=csv|json|tsv                         output format ( csv )\n"
+           "  --output=FILE                                 output file ( stdout )\n"
+           "  --schema                                      print the schema of the output and exit\n"
+           "suites:",
+           program );
+  for ( const char * const  p : suites_ )
+    fprintf( stderr, " %s", p );
+  fprintf( stderr, "\ndistributions:" );
+  for ( const char * const  p : distributions_ )
+    fprintf( stderr, " %s", p );
+  fprintf( stderr, "\n" );
+}
+
+} // namespace bench
@@ -0,0 +1,72 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+// command-line options of the benchmark
+
+
+#ifndef  OCTREE_DIDACTIC_BENCHMARK_OPTIONS_HPP
+#define  OCTREE_DIDACTIC_BENCHMARK_OPTIONS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace  bench {
+
+struct  Options {
+  Options();
+  // the suites to run ( see bench::isSuite() ):
+  std::vector<std::string>  suites;
+  // the numbers of points of the search space, one set of rows per number:
+  std::vector<std::size_t>  sizes;
+  // the number of independently generated search spaces per size:
+  std::size_t    numRuns;
+  // the seed of all the random numbers, the same seed gives the same input:
+  std::uint64_t  seed;
+  // the generator of the points ( see bench::isDistribution() ):
+  std::string    distribution;
+  // the tolerance of every query is drawn uniformly from this range:
+  double         toleranceMin;
+  double         toleranceMax;
+  // the share of the queries that have no match ( see bench::generateQueries() ),
+  // negative - the queries are plain perturbations of the points:
+  double         missRatio;
+  // the exponent of the Zipf law the targets of the queries follow,
+  // 0 - every point is the target of a single query:
+  double         querySkew;
+  // the number of consecutive queries timed together:
+  std::size_t    batchSize;
+  // the untimed passes over the queries before they are timed:
+  std::size_t    numWarmUps;
+  // the 'complexity' suite flags the total cost of n operations
+  // growing faster than n^maxExponent:
+  double         maxExponent;
+  // whether the hardware counters are read ( see bench::Counters ):
+  bool           isCounters;
+  // the CPU the benchmark is bound to ( -1 - not bound ):
+  int            iCpu;
+  // "csv", "json" or "tsv":
+  std::string    format;
+  // the output file ( stdout if empty ):
+  std::string    output;
+  bool           isHelp;
+  bool           isSchema;
+};
+
+// returns false and reports the reason to stderr
+// if 'argv' contains an invalid option:
+bool  parseOptions( const int  argc, char * argv[], Options&  options );
+
+void  printUsage( const char * const  program );
+
+bool  isDistribution( const std::string&  name );
+
+bool  isSuite( const std::string&  name );
+
+} // namespace bench
+
+#endif // OCTREE_DIDACTIC_BENCHMARK_OPTIONS_HPP
@@ -0,0 +1,245 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+
+
+#include "report.hpp"
+
+#include "octree.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+
+
+
+namespace  bench {
+
+const Column  columns[]  =  {
+  { "suite",        "",   "the benchmarked operation" },
+  { "variant",      "",   "the implementation of the operation" },
+  { "distribution", "",   "the generator of the points" },
+  { "num_points",   "",   "the number of points of the search space" },
+  { "num_runs",     "",   "the number of generated search spaces" },
+  { "num_queries",  "",   "the number of queries ( or points, or nodes ) per search space" },
+  { "batch_size",   "",   "the number of consecutive queries timed together" },
+  { "num_warmups",  "",   "the untimed passes over the queries of a run before they are timed" },
+  { "mean_ns",      "ns", "the mean time per query" },
+  { "sd_ns",        "ns", "the standard deviation of the time per query of a batch" },
+  { "p50_ns",       "ns", "the median time per query of a batch" },
+  { "p90_ns",       "ns", "the 90th percentile of the time per query of a batch" },
+  { "p99_ns",       "ns", "the 99th percentile of the time per query of a batch" },
+  { "p999_ns",      "ns", "the 99.9th percentile of the time per query of a batch" },
+  { "max_ns",       "ns", "the maximal time per query of a batch" },
+  { "num_errors",   "",   "the queries whose result is out of tolerance or disagrees with std::find_if" },
+  { "num_misses",   "",   "the queries with no match according to std::find_if" },
+  { "num_not_found", "",  "the points of a run find() does not return after inserting them, the mean over the runs" },
+  { "points_per_s", "1/s", "the points built, inserted or destroyed per second" },
+  { "num_stored",   "",   "the elements a tree holds after the inserts of a run, the mean over the runs" },
+  { "ns_per_stored", "ns", "the time of the inserts of a run per element stored ( the dropped points included )" },
+  { "rss_bytes",    "B",  "the largest growth of the resident set caused by building a tree" },
+  { "peak_rss_bytes", "B", "the peak resident set of the process so far" },
+  { "bytes_per_point", "B", "the memory held by a tree according to Octree::stats() per point" },
+  { "rss_bytes_per_point", "B", "rss_bytes per point" },
+  { "exponent",     "",   "the exponent k of the fit 'total time of n operations ~ n^k' over all the sizes" },
+  { "is_superlinear", "", "1 if the exponent exceeds --max-exponent" },
+  { "nodes_per_query", "",  "the nodes touched per query ( QueryStats::numNodesTouched )" },
+  { "cycles_per_query", "", "the CPU cycles per query ( --counters )" },
+  { "instructions_per_query", "", "the instructions retired per query ( --counters )" },
+  { "l1d_misses_per_query", "", "the L1 data cache read misses per query ( --counters )" },
+  { "llc_misses_per_query", "", "the last level cache read misses per query ( --counters )" },
+  { "branch_misses_per_query", "", "the mispredicted branches per query ( --counters )" },
+  { "dtlb_misses_per_query", "", "the data TLB read misses per query ( --counters )" },
+  { "cycles_per_node", "", "cycles_per_query per node touched" },
+  { "instructions_per_node", "", "instructions_per_query per node touched" },
+  { "l1d_misses_per_node", "", "l1d_misses_per_query per node touched" },
+  { "llc_misses_per_node", "", "llc_misses_per_query per node touched" },
+  { "branch_misses_per_node", "", "branch_misses_per_query per node touched" },
+  { "dtlb_misses_per_node", "", "dtlb_misses_per_query per node touched" }
+};
+const std::size_t  numColumns  =  std::end( columns ) - std::begin( columns );
+
+
+static
+std::string
+escape_( const std::string&  in, const bool  isJson )
+{
+  std::string  out( 1, '"' );
+  for ( const char  c : in )
+  {
+    if ( '"' == c )
+      out  +=  ( true == isJson ) ? "\\\"" : "\"\"";
+    else
+    if ( '\\' == c
+      && true == isJson
+       )
+      out  +=  "\\\\";
+    else
+      out  +=  c;
+  }
+  out  +=  '"';
+  return  out;
+}
+
+
+static
+bool
+isColumn_( const char * const  name )
+{
+  for ( std::size_t  i = 0; i < numColumns; ++i )
+    if ( std::string( columns[ i ].name ) == name )
+      return  true;
+  return  false;
+}
+
+
+Row&
+Row::set( const char * const  column, const double  value )
+{
+  if ( false == isColumn_( column ) )
+  {
+    fprintf( stderr, "unknown column: %s\n", column );
+    std::abort();
+  }
+  Cell_&  cell  =  cells_[ column ];
+  cell.isText  =  false;
+  cell.number  =  value;
+  return  *this;
+}
+
+
+Row&
+Row::set( const char * const  column, const std::string&  value )
+{
+  if ( false == isColumn_( column ) )
+  {
+    fprintf( stderr, "unknown column: %s\n", column );
+    std::abort();
+  }
+  Cell_&  cell  =  cells_[ column ];
+  cell.isText  =  true;
+  cell.text  =  value;
+  return  *this;
+}
+
+
+bool
+Row::get( const char * const  column, std::string&  out, const bool  isJson ) const
+{
+  const std::map<std::string, Cell_>::const_iterator  it  =  cells_.find( column );
+  if ( cells_.end() == it )
+    return  false;
+  if ( true == it->second.isText )
+  {
+    out  =  escape_( it->second.text, isJson );
+    return  true;
+  }
+  // json has no representation of nan and infinity:
+  if ( false == std::isfinite( it->second.number ) )
+  {
+    out  =  ( true == isJson ) ? "null" : "";
+    return  true;
+  }
+  char  buf[ 64 ];
+  snprintf( buf, sizeof( buf ), "%.10g", it->second.number );
+  out  =  buf;
+  return  true;
+}
+
+
+void
+printSchema( FILE * const  pF )
+{
+  fprintf( pF, "{\n    \"version\": %u,\n    \"columns\": [\n", schemaVersion );
+  for ( std::size_t  i = 0; i < numColumns; ++i )
+    fprintf( pF, "      { \"name\": %s, \"unit\": %s, \"description\": %s }%s\n",
+             escape_( columns[ i ].name, true ).c_str(),
+             escape_( columns[ i ].unit, true ).c_str(),
+             escape_( columns[ i ].description, true ).c_str(),
+             ( numColumns == i + 1 ) ? "" : "," );
+  fprintf( pF, "    ]\n  }" );
+}
+
+
+Report::Report( const Options&  options, FILE * const  pF ) : pF_( pF ),
+                                                              format_( options.format ),
+                                                              numRows_( 0 )
+{
+  if ( "json" == format_ )
+  {
+    fprintf( pF_, "{\n  \"schema\": " );
+    printSchema( pF_ );
+    fprintf( pF_, ",\n  \"options\": {\n" );
+    fprintf( pF_, "    \"sizes\": [" );
+    for ( std::size_t  i = 0; i < options.sizes.size(); ++i )
+      fprintf( pF_, "%s%lu", ( 0 == i ) ? "" : ", ", static_cast<unsigned long>( options.sizes[ i ] ) );
+    fprintf( pF_, "],\n" );
+    fprintf( pF_, "    \"runs\": %lu,\n", static_cast<unsigned long>( options.numRuns ) );
+    fprintf( pF_, "    \"seed\": %llu,\n", static_cast<unsigned long long>( options.seed ) );
+    fprintf( pF_, "    \"distribution\": %s,\n", escape_( options.distribution, true ).c_str() );
+    fprintf( pF_, "    \"tolerance\": [%.10g, %.10g],\n", options.toleranceMin, options.toleranceMax );
+    if ( 0 <= options.missRatio )
+      fprintf( pF_, "    \"miss_ratio\": %.10g,\n", options.missRatio );
+    else
+      fprintf( pF_, "    \"miss_ratio\": null,\n" );
+    fprintf( pF_, "    \"query_skew\": %.10g,\n", options.querySkew );
+    fprintf( pF_, "    \"batch\": %lu,\n", static_cast<unsigned long>( options.batchSize ) );
+    fprintf( pF_, "    \"warmup\": %lu,\n", static_cast<unsigned long>( options.numWarmUps ) );
+    fprintf( pF_, "    \"max_exponent\": %.10g,\n", options.maxExponent );
+    fprintf( pF_, "    \"counters\": %s,\n", ( true == options.isCounters ) ? "true" : "false" );
+    // a build setting rather than an option ( see octree.hpp ):
+    fprintf( pF_, "    \"prefetch\": %d,\n", OCTREE_DIDACTIC_PREFETCH );
+    fprintf( pF_, "    \"cpu\": %d\n", options.iCpu );
+    fprintf( pF_, "  },\n  \"rows\": [" );
+    return;
+  }
+  const char  separator  =  ( "tsv" == format_ ) ? '\t' : ',';
+  for ( std::size_t  i = 0; i < numColumns; ++i )
+    fprintf( pF_, "%s%c", columns[ i ].name, ( numColumns == i + 1 ) ? '\n' : separator );
+}
+
+
+Report::~Report()
+{
+  if ( "json" == format_ )
+    fprintf( pF_, "\n  ]\n}\n" );
+  fflush( pF_ );
+}
+
+
+void
+Report::write( const Row&  row )
+{
+  const bool  isJson  =  ( "json" == format_ );
+  if ( true == isJson )
+  {
+    fprintf( pF_, "%s\n    {", ( 0 == numRows_ ) ? "" : "," );
+    bool  isFirst  =  true;
+    for ( std::size_t  i = 0; i < numColumns; ++i )
+    {
+      std::string  value;
+      if ( false == row.get( columns[ i ].name, value, true ) )
+        continue;
+      fprintf( pF_, "%s\"%s\": %s", ( true == isFirst ) ? " " : ", ", columns[ i ].name, value.c_str() );
+      isFirst  =  false;
+    }
+    fprintf( pF_, " }" );
+  }
+  else
+  {
+    const char  separator  =  ( "tsv" == format_ ) ? '\t' : ',';
+    for ( std::size_t  i = 0; i < numColumns; ++i )
+    {
+      std::string  value;
+      row.get( columns[ i ].name, value, false );
+      fprintf( pF_, "%s%c", value.c_str(), ( numColumns == i + 1 ) ? '\n' : separator );
+    }
+  }
+  ++numRows_;
+  fflush( pF_ );
+}
+
+} // namespace bench
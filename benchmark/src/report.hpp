@@ -0,0 +1,74 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+// machine-readable output of the benchmark
+
+
+#ifndef  OCTREE_DIDACTIC_BENCHMARK_REPORT_HPP
+#define  OCTREE_DIDACTIC_BENCHMARK_REPORT_HPP
+
+#include "options.hpp"
+
+#include <cstdio>
+#include <map>
+#include <string>
+
+namespace  bench {
+
+// the version of the set of columns below,
+// to be incremented whenever a column changes its meaning:
+constexpr unsigned  schemaVersion  =  9;
+
+struct  Column {
+  const char  *name;
+  const char  *unit;
+  const char  *description;
+};
+
+// all the columns a row may have, in the order of the csv/tsv output:
+extern const Column  columns[];
+extern const std::size_t  numColumns;
+
+// one measurement; a column left unset is written as an empty csv field
+// and omitted from the json output:
+class  Row {
+  public:
+    Row&  set( const char * const  column, const double  value );
+    Row&  set( const char * const  column, const std::string&  value );
+    bool  get( const char * const  column, std::string&  out, const bool  isJson ) const;
+  private:
+    struct  Cell_ {
+      bool         isText;
+      double       number;
+      std::string  text;
+    };
+    std::map<std::string, Cell_>  cells_;
+};
+
+// writes the rows to a file or stdout in the format of the options:
+// the csv/tsv output starts with a header, the json output is an object
+// holding the schema, the options and an array of the rows:
+class  Report {
+  public:
+    // 'pF' stays open after the report is destroyed:
+    Report( const Options&  options, FILE * const  pF );
+    ~Report();
+    void  write( const Row&  row );
+  private:
+    Report( const Report& );
+    Report&  operator=( const Report& );
+  private:
+    FILE         *pF_;
+    std::string  format_;
+    std::size_t  numRows_;
+};
+
+// the schema as a json object:
+void  printSchema( FILE * const  pF );
+
+} // namespace bench
+
+#endif // OCTREE_DIDACTIC_BENCHMARK_REPORT_HPP
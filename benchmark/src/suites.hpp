@@ -0,0 +1,67 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+// the suites of the benchmark, each one writes its rows for a single size
+// ( but the 'complexity' one )
+
+
+#ifndef  OCTREE_DIDACTIC_BENCHMARK_SUITES_HPP
+#define  OCTREE_DIDACTIC_BENCHMARK_SUITES_HPP
+
+#include "options.hpp"
+#include "report.hpp"
+
+#include <cstddef>
+
+namespace  bench {
+
+// Octree::find() against std::find_if(), std::search() and the baselines:
+void  runFind( const Options&      options,
+               const std::size_t&  numPoints,
+               Report&             report
+             ) noexcept;
+
+// Octree::init() on shuffled and on sorted input,
+// and the preparation of the baselines of the 'find' suite:
+void  runBuild( const Options&      options,
+                const std::size_t&  numPoints,
+                Report&             report
+              ) noexcept;
+
+// Octree::insert() of single points in a random and in the x1 order:
+void  runInsert( const Options&      options,
+                 const std::size_t&  numPoints,
+                 Report&             report
+               ) noexcept;
+
+// ~Octree() of a tree built by Octree::init() and of its clone:
+void  runDestroy( const Options&      options,
+                  const std::size_t&  numPoints,
+                  Report&             report
+                ) noexcept;
+
+// the resident memory held by a tree built by Octree::init():
+void  runMemory( const Options&      options,
+                 const std::size_t&  numPoints,
+                 Report&             report
+               ) noexcept;
+
+// the private traversal routines of Octree::find() on single chains:
+void  runTraversal( const Options&      options,
+                    const std::size_t&  numPoints,
+                    Report&             report
+                  ) noexcept;
+
+// Octree::insert(), Octree::find() and ~Octree() over all the sizes at once:
+// fits the exponent of the growth of their cost with the number of points
+// and returns false if any of them grows faster than 'options.maxExponent':
+bool  runComplexity( const Options&  options,
+                     Report&         report
+                   ) noexcept;
+
+} // namespace bench
+
+#endif // OCTREE_DIDACTIC_BENCHMARK_SUITES_HPP
@@ -0,0 +1,90 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+
+
+#include "timing.hpp"
+
+#include <cmath>
+#include <limits>
+
+#if defined( __linux__ )
+#include <sched.h>
+#endif
+
+
+
+namespace  bench {
+
+static
+double
+percentile_( const std::vector<double>&  sorted, const double  fraction )
+{
+  // the smallest sample not exceeded by 'fraction' of all the samples:
+  const double  rank  =  std::ceil( fraction * sorted.size() );
+  const std::size_t  i  =  ( 1 > rank ) ? 0 : static_cast<std::size_t>( rank ) - 1;
+  return  sorted[ std::min( i, sorted.size() - 1 ) ];
+}
+
+
+Latency
+summarize( std::vector<double>&  samples )
+{
+  const double  nan  =  std::numeric_limits<double>::quiet_NaN();
+  Latency  out  =  { nan, nan, nan, nan, nan, nan, nan };
+  if ( true == samples.empty() )
+    return  out;
+
+  std::sort( samples.begin(), samples.end() );
+  double  sum  =  0;
+  for ( const double  sample : samples )
+    sum  +=  sample;
+  out.mean  =  sum / samples.size();
+  double  sumSquares  =  0;
+  for ( const double  sample : samples )
+    sumSquares  +=  ( sample - out.mean ) * ( sample - out.mean );
+  out.sd  =  std::sqrt( sumSquares / samples.size() );
+  out.p50  =  percentile_( samples, 0.5 );
+  out.p90  =  percentile_( samples, 0.9 );
+  out.p99  =  percentile_( samples, 0.99 );
+  out.p999  =  percentile_( samples, 0.999 );
+  out.max  =  samples.back();
+  return  out;
+}
+
+
+void
+setLatency( Row&  row, const Latency&  latency )
+{
+  row.set( "mean_ns", latency.mean )
+     .set( "sd_ns", latency.sd )
+     .set( "p50_ns", latency.p50 )
+     .set( "p90_ns", latency.p90 )
+     .set( "p99_ns", latency.p99 )
+     .set( "p999_ns", latency.p999 )
+     .set( "max_ns", latency.max );
+}
+
+
+bool
+pinToCpu( const int  iCpu )
+{
+#if defined( __linux__ )
+  if ( 0 > iCpu
+    || CPU_SETSIZE <= iCpu
+     )
+    return  false;
+  cpu_set_t  set;
+  CPU_ZERO( &set );
+  CPU_SET( iCpu, &set );
+  return  0 == sched_setaffinity( 0, sizeof( set ), &set );
+#else
+  ( void ) iCpu;
+  return  false;
+#endif
+}
+
+} // namespace bench
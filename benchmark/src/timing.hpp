@@ -0,0 +1,74 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+// batched timing and latency percentiles of the benchmark
+
+
+#ifndef  OCTREE_DIDACTIC_BENCHMARK_TIMING_HPP
+#define  OCTREE_DIDACTIC_BENCHMARK_TIMING_HPP
+
+#include "report.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace  bench {
+
+typedef  std::chrono::steady_clock  Clock;
+
+// the time per query in nanoseconds:
+struct  Latency {
+  double  mean;
+  double  sd;
+  double  p50;
+  double  p90;
+  double  p99;
+  double  p999;
+  double  max;
+};
+
+// the nearest-rank percentiles of 'samples' ( sorted in place ):
+Latency  summarize( std::vector<double>&  samples );
+
+// sets the *_ns columns of 'row':
+void  setLatency( Row&  row, const Latency&  latency );
+
+// binds the calling thread to the CPU 'iCpu',
+// returns false if it is not supported or the CPU is not available:
+bool  pinToCpu( const int  iCpu );
+
+// calls 'query( i )' for all 'i' in [ 0, numQueries ) in batches of 'batchSize'
+// consecutive queries and appends the mean time per query of every batch
+// to 'samples'; a batch is timed as a whole, so that the resolution
+// and the overhead of the clock are spread over the batch;
+// 'query.prepare( i )' is called before every batch of a single query
+// and is not timed:
+template<class  Q>
+void
+timeBatches( Q&                    query,
+             const std::size_t&    numQueries,
+             const std::size_t&    batchSize,
+             std::vector<double>&  samples
+           )
+{
+  for ( std::size_t  iBegin = 0; iBegin < numQueries; iBegin += batchSize )
+  {
+    const std::size_t  iEnd  =  std::min( iBegin + batchSize, numQueries );
+    if ( 1 == iEnd - iBegin )
+      query.prepare( iBegin );
+    const Clock::time_point  start  =  Clock::now();
+    for ( std::size_t  i = iBegin; i < iEnd; ++i )
+      query( i );
+    const Clock::time_point  end  =  Clock::now();
+    samples.push_back( std::chrono::duration<double, std::nano>( end - start ).count() / ( iEnd - iBegin ) );
+  }
+}
+
+} // namespace bench
+
+#endif // OCTREE_DIDACTIC_BENCHMARK_TIMING_HPP
@@ -0,0 +1,197 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+// the 'traversal' suite: the private traversal routines of Octree::find()
+// timed in isolation on single chains of a controlled shape
+
+
+#include "suites.hpp"
+#include "timing.hpp"
+#include "workload.hpp"
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+
+
+namespace  {
+
+struct  TraversalTag_ {};
+
+} // namespace
+
+
+namespace  d7cA {
+
+// calls the routine 'iRoutine' ( see 'routines_' below ) at the root of 'tree':
+template<>
+class  OctreeAccess<TraversalTag_> {
+  public:
+    typedef  Octree<Point, double>     Tree;
+    typedef  OctreeObj<Point, double>  Node;
+    template<class  S>
+    static const Node *  traverse( const unsigned short  iRoutine,
+                                   const Tree&           tree,
+                                   const Point<double>&  ob,
+                                   const double&         tolerance,
+                                   S&                    stats
+                                 ) noexcept
+    {
+      switch ( iRoutine )
+      {
+        case 0:  return  tree.moveAlongWestEast_( ob, tolerance, tree.root_, stats );
+        case 1:  return  tree.moveAlongNWSE_( ob, tolerance, tree.root_, stats );
+        case 2:  return  tree.moveAlongSWNE_( ob, tolerance, tree.root_, stats );
+        case 3:  return  tree.findIn_NWSE_SWNE_( ob, stats, tolerance, tree.root_ );
+        default: return  tree.findIn_WestEast_NWSE_SWNE_( ob, stats, tolerance, tree.root_ );
+      }
+    }
+};
+
+} // namespace d7cA
+
+
+namespace  {
+
+typedef  d7cA::OctreeAccess<TraversalTag_>  Access_;
+
+// a routine and the chain it is timed on:
+// 1 - a W/E chain, 2 - a NW/SE chain, 3 - a SW/NE chain
+// ( the routines searching the lower levels start at a node
+//   within the tolerance along the levels above the chain ):
+struct  Routine_ {
+  const char      *name;
+  unsigned short  iPair;
+};
+
+const Routine_  routines_[]  =  { { "moveAlongWestEast_", 1 },
+                                  { "moveAlongNWSE_", 2 },
+                                  { "moveAlongSWNE_", 3 },
+                                  { "findIn_NWSE_SWNE_", 3 },
+                                  { "findIn_WestEast_NWSE_SWNE_", 2 } };
+
+const char * const  shapes_[ 4 ]  =  { "", "west_east_chain", "nw_se_chain", "sw_ne_chain" };
+
+// 'exact' looks for a stored point with no tolerance,
+// 'wide' is within the tolerance of every node along the chain
+// and out of the tolerance of all of them along x1, so that it misses
+// after visiting the whole chain:
+const char * const  tolerances_[ 2 ]  =  { "exact", "wide" };
+
+
+struct  Traverse_ {
+  Traverse_( const unsigned short                      iRoutine,
+             const Access_::Tree&                      octree,
+             const std::vector<bench::Query>&          queries,
+             std::vector<const Access_::Node *>&       results
+           ) : iRoutine( iRoutine ),
+               octree( octree ),
+               queries( queries ),
+               results( results )
+  { }
+  void  prepare( const std::size_t& ) noexcept { }
+  void  operator()( const std::size_t&  i ) noexcept
+  {
+    d7cA::NoQueryStats  stats;
+    results[ i ]  =  Access_::traverse( iRoutine, octree, queries[ i ].p, queries[ i ].tolerance, stats );
+  }
+  unsigned short                       iRoutine;
+  const Access_::Tree&                 octree;
+  const std::vector<bench::Query>&     queries;
+  std::vector<const Access_::Node *>&  results;
+};
+
+
+// the points of a single chain of the pair 'iPair': the coordinates above
+// 'x(iPair+1)' are shared, 'x(iPair+1)' is the index of a point
+// and the coordinates below it are random:
+static
+void
+generateChain_( const unsigned short                 iPair,
+                std::mt19937&                        gen,
+                std::vector<d7cA::Point<double> >&   vecPoints
+              )
+{
+  const std::size_t  numPoints  =  vecPoints.size();
+  std::uniform_real_distribution<>  dist( 0, static_cast<double>( numPoints ) );
+  for ( std::size_t i = 0; i < numPoints; ++i )
+  {
+    double  x[ 4 ]  =  { 0, 0, 0, 0 };
+    x[ iPair ]  =  static_cast<double>( i );
+    for ( unsigned short  k = iPair + 1; k < 4; ++k )
+      x[ k ]  =  dist( gen );
+    vecPoints[ i ]  =  d7cA::Point<double>( x[ 0 ], x[ 1 ], x[ 2 ], x[ 3 ] );
+  }
+}
+
+} // namespace
+
+
+
+void
+bench::runTraversal( const bench::Options&  options,
+                     const std::size_t&     numPoints,
+                     bench::Report&         report
+                   ) noexcept
+{
+  std::mt19937  gen;
+  bench::seedGenerator( gen, options, numPoints );
+
+  constexpr std::size_t  numRoutines  =  sizeof( routines_ ) / sizeof( routines_[ 0 ] );
+  std::vector<double>  vecSamples[ numRoutines ][ 2 ];
+  std::size_t          numNodesTouched[ numRoutines ][ 2 ]  =  { };
+
+  std::vector<d7cA::Point<double> >   vecPoints( numPoints );
+  std::vector<bench::Query>           vecQueries( numPoints );
+  std::vector<const Access_::Node *>  vecResults( numPoints, nullptr );
+  std::uniform_int_distribution<std::size_t>  distTarget( 0, numPoints - 1 );
+  for ( std::size_t  iRun = 0; iRun < options.numRuns; ++iRun )
+    for ( std::size_t  iRoutine = 0; iRoutine < numRoutines; ++iRoutine )
+    {
+      generateChain_( routines_[ iRoutine ].iPair, gen, vecPoints );
+      Access_::Tree  octree;
+      octree.init( vecPoints.data(), numPoints, d7cA::comparePoints<double> );
+      for ( std::size_t  iTolerance = 0; iTolerance < 2; ++iTolerance )
+      {
+        for ( bench::Query&  query : vecQueries )
+        {
+          const d7cA::Point<double>&  p  =  vecPoints[ distTarget( gen ) ];
+          query.p  =  ( 0 == iTolerance ) ? p : d7cA::Point<double>( 3.0 * numPoints, p.x2(), p.x3(), p.x4() );
+          query.tolerance  =  ( 0 == iTolerance ) ? 0 : static_cast<double>( numPoints );
+        }
+        Traverse_  traverse( iRoutine, octree, vecQueries, vecResults );
+        for ( std::size_t  iWarmUp = 0; iWarmUp < options.numWarmUps; ++iWarmUp )
+          for ( std::size_t i = 0; i < numPoints; ++i )
+            traverse( i );
+        bench::timeBatches( traverse, numPoints, options.batchSize, vecSamples[ iRoutine ][ iTolerance ] );
+        for ( const bench::Query&  query : vecQueries )
+        {
+          d7cA::QueryStats  stats;
+          Access_::traverse( iRoutine, octree, query.p, query.tolerance, stats );
+          numNodesTouched[ iRoutine ][ iTolerance ]  +=  stats.numNodesTouched;
+        }
+      }
+    }
+
+  for ( std::size_t  iRoutine = 0; iRoutine < numRoutines; ++iRoutine )
+    for ( std::size_t  iTolerance = 0; iTolerance < 2; ++iTolerance )
+    {
+      bench::Row  row;
+      row.set( "suite", std::string( "traversal" ) )
+         .set( "variant", std::string( routines_[ iRoutine ].name ) + "/" + tolerances_[ iTolerance ] )
+         .set( "distribution", std::string( shapes_[ routines_[ iRoutine ].iPair ] ) )
+         .set( "num_points", numPoints )
+         .set( "num_runs", options.numRuns )
+         .set( "num_queries", numPoints )
+         .set( "batch_size", options.batchSize )
+         .set( "num_warmups", options.numWarmUps )
+         .set( "nodes_per_query", static_cast<double>( numNodesTouched[ iRoutine ][ iTolerance ] ) / numPoints / options.numRuns );
+      bench::setLatency( row, bench::summarize( vecSamples[ iRoutine ][ iTolerance ] ) );
+      report.write( row );
+    }
+}
@@ -0,0 +1,384 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+
+
+#include "workload.hpp"
+
+#include "baselines.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+
+
+
+namespace  bench {
+
+// "gaussian": the points scatter around a few centres drawn uniformly:
+static
+void
+generateGaussian_( std::mt19937&          gen,
+                   d7cA::Point<double> *  arrPoints,
+                   const std::size_t&     numPoints
+                 ) noexcept
+{
+  constexpr std::size_t  numClusters  =  16;
+  std::uniform_real_distribution<>  dist( -50, +50 );
+  std::normal_distribution<>        distOffset( 0, 2 );
+  std::uniform_int_distribution<std::size_t>  distCluster( 0, numClusters - 1 );
+  double  aCentres[ numClusters ][ 4 ];
+  for ( std::size_t  c = 0; c < numClusters; ++c )
+    for ( unsigned short  k = 0; k < 4; ++k )
+      aCentres[ c ][ k ]  =  dist( gen );
+  for ( std::size_t i = 0; i < numPoints; ++i )
+  {
+    const double * const  x  =  aCentres[ distCluster( gen ) ];
+    const double  x1  =  x[ 0 ] + distOffset( gen );
+    const double  x2  =  x[ 1 ] + distOffset( gen );
+    const double  x3  =  x[ 2 ] + distOffset( gen );
+    const double  x4  =  x[ 3 ] + distOffset( gen );
+    arrPoints[ i ]  =  d7cA::Point<double>( x1, x2, x3, x4 );
+  }
+}
+
+
+// "trajectory": random walks of objects sampled at common instants,
+// x1 is the time and x2, x3, x4 are the position of an object:
+static
+void
+generateTrajectories_( std::mt19937&          gen,
+                       d7cA::Point<double> *  arrPoints,
+                       const std::size_t&     numPoints
+                     ) noexcept
+{
+  const std::size_t  numObjects  =  1 + numPoints / 64;
+  const std::size_t  numSteps  =  ( numPoints + numObjects - 1 ) / numObjects;
+  std::uniform_real_distribution<>  dist( -50, +50 );
+  std::normal_distribution<>        distStep( 0, 0.5 );
+  std::vector<double>  vecPositions( 3 * numObjects );
+  for ( double&  x : vecPositions )
+    x  =  dist( gen );
+  for ( std::size_t i = 0; i < numPoints; ++i )
+  {
+    const std::size_t  iStep  =  i / numObjects;
+    double * const  x  =  &vecPositions[ 3 * ( i % numObjects ) ];
+    for ( unsigned short  k = 0; k < 3; ++k )
+      x[ k ]  +=  distStep( gen );
+    const double  time  =  -50 + 100.0 * iStep / numSteps;
+    arrPoints[ i ]  =  d7cA::Point<double>( time, x[ 0 ], x[ 1 ], x[ 2 ] );
+  }
+}
+
+
+// "duplicates": every point is a copy of one of a few distinct points:
+static
+void
+generateDuplicates_( std::mt19937&          gen,
+                     d7cA::Point<double> *  arrPoints,
+                     const std::size_t&     numPoints
+                   ) noexcept
+{
+  const std::size_t  numDistinct  =  1 + numPoints / 16;
+  std::uniform_real_distribution<>  dist( -50, +50 );
+  std::uniform_int_distribution<std::size_t>  distDistinct( 0, numDistinct - 1 );
+  std::vector<d7cA::Point<double> >  vecDistinct( numDistinct );
+  for ( d7cA::Point<double>&  p : vecDistinct )
+  {
+    const double  x1  =  dist( gen );
+    const double  x2  =  dist( gen );
+    const double  x3  =  dist( gen );
+    const double  x4  =  dist( gen );
+    p  =  d7cA::Point<double>( x1, x2, x3, x4 );
+  }
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    arrPoints[ i ]  =  vecDistinct[ distDistinct( gen ) ];
+}
+
+
+// the inputs degrading the structure built by Octree::insert():
+// "same_x1" - uniform points sharing x1 ( a single giant W/E chain ),
+// "sorted", "reverse_sorted" - uniform points in the ascending or descending
+// 'comparePoints' order, "sawtooth" - the same points taken alternately
+// from the lowest and the highest end:
+static
+void
+generateAdversarial_( const std::string&     distribution,
+                      std::mt19937&          gen,
+                      d7cA::Point<double> *  arrPoints,
+                      const std::size_t&     numPoints
+                    ) noexcept
+{
+  std::uniform_real_distribution<>  dist( -50, +50 );
+  for ( std::size_t i = 0; i < numPoints; ++i )
+  {
+    const double  x1  =  ( "same_x1" == distribution ) ? 0 : dist( gen );
+    const double  x2  =  dist( gen );
+    const double  x3  =  dist( gen );
+    const double  x4  =  dist( gen );
+    arrPoints[ i ]  =  d7cA::Point<double>( x1, x2, x3, x4 );
+  }
+  if ( "same_x1" == distribution )
+    return;
+  std::sort( arrPoints, arrPoints + numPoints, d7cA::comparePoints<double> );
+  if ( "reverse_sorted" == distribution )
+    std::reverse( arrPoints, arrPoints + numPoints );
+  if ( "sawtooth" == distribution )
+  {
+    const std::vector<d7cA::Point<double> >  vecSorted( arrPoints, arrPoints + numPoints );
+    std::size_t  iLow  =  0;
+    std::size_t  iHigh  =  numPoints;
+    for ( std::size_t i = 0; i < numPoints; ++i )
+      arrPoints[ i ]  =  ( 0 == i % 2 ) ? vecSorted[ iLow++ ] : vecSorted[ --iHigh ];
+  }
+}
+
+
+void
+seedGenerator( std::mt19937&       gen,
+               const Options&      options,
+               const std::size_t&  numPoints
+             )
+{
+  std::seed_seq  seq{ static_cast<std::uint32_t>( options.seed ),
+                      static_cast<std::uint32_t>( options.seed >> 32 ),
+                      static_cast<std::uint32_t>( numPoints ) };
+  gen.seed( seq );
+}
+
+
+void
+generatePoints( const std::string&     distribution,
+                std::mt19937&          gen,
+                d7cA::Point<double> *  arrPoints,
+                const std::size_t&     numPoints
+              ) noexcept
+{
+  // distribution for individual spatial coordinates:
+  std::uniform_real_distribution<>  dist( -50, +50 );
+
+  if ( "uniform" == distribution )
+  {
+    for ( std::size_t i = 0; i < numPoints; ++i )
+    {
+      const double  x1  =  dist( gen );
+      const double  x2  =  dist( gen );
+      const double  x3  =  dist( gen );
+      const double  x4  =  dist( gen );
+      arrPoints[ i ]  =  d7cA::Point<double>( x1, x2, x3, x4 );
+    }
+    return;
+  }
+  if ( "gaussian" == distribution )
+  {
+    generateGaussian_( gen, arrPoints, numPoints );
+    return;
+  }
+  if ( "trajectory" == distribution )
+  {
+    generateTrajectories_( gen, arrPoints, numPoints );
+    return;
+  }
+  if ( "duplicates" == distribution )
+  {
+    generateDuplicates_( gen, arrPoints, numPoints );
+    return;
+  }
+  if ( "same_x1" == distribution
+    || "sorted" == distribution
+    || "reverse_sorted" == distribution
+    || "sawtooth" == distribution
+     )
+  {
+    generateAdversarial_( distribution, gen, arrPoints, numPoints );
+    return;
+  }
+
+  // "grouped": groups of points share the values of certain coordinates;
+  // distribution for numbers of points that will have
+  // the same values of certain coordinates:
+  std::uniform_int_distribution<>   distInt( 1, 10 );
+  // choose what coordinates will have the same values,
+  // bit 'k' of a mask stands for the coordinate 'x(k+1)':
+  // x1, x2, x3, x4, x1 & x2, x1 & x3, x1 & x4, x2 & x3, x2 & x4, x3 & x4,
+  // x1 & x2 & x3, x2 & x3 & x4, x3 & x4 & x1, x4 & x1 & x2,
+  // all coords values are different ( a group of a single point ):
+  const unsigned short  aMasks[]  =  { 1, 2, 4, 8, 3, 5, 9, 6, 10, 12, 7, 14, 13, 11, 0 };
+  std::uniform_int_distribution<>   distCoord( 0, std::end( aMasks ) - std::begin( aMasks ) - 1 );
+
+  for ( std::size_t i = 0; i < numPoints; )
+  {
+    const unsigned short  mask  =  aMasks[ distCoord( gen ) ];
+    const std::size_t  numPointsSameCoordValue  =  ( 0 == mask ) ? 1 : distInt( gen );
+    double  aShared[ 4 ];
+    for ( unsigned short  k = 0; k < 4; ++k )
+      aShared[ k ]  =  ( 0 != ( mask & ( 1 << k ) ) ) ? dist( gen ) : 0;
+    for ( std::size_t j = 0; j < numPointsSameCoordValue && i < numPoints; ++j )
+    {
+      double  x[ 4 ];
+      for ( unsigned short  k = 0; k < 4; ++k )
+        x[ k ]  =  ( 0 != ( mask & ( 1 << k ) ) ) ? aShared[ k ] : dist( gen );
+      arrPoints[ i ]  =  d7cA::Point<double>( x[ 0 ], x[ 1 ], x[ 2 ], x[ 3 ] );
+      ++i;
+    }
+  }
+}
+
+
+d7cA::Point<double>
+makeQuery( const d7cA::Point<double>&  p,
+           std::mt19937&               gen
+         ) noexcept
+{
+  std::uniform_real_distribution<>  distVariation( -1.5, +1.5 );
+  std::uniform_int_distribution<>   distVarChoice( 0, 4 );
+  // 0..3 - only one of x1, x2, x3 and x4 is variated,
+  // 4 - all the x1, x2, x3 and x4 are variated independently:
+  const int  var  =  distVarChoice( gen );
+  double  aVariation[ 4 ]  =  { 0, 0, 0, 0 };
+  for ( short k = 0; k < 4; ++k )
+    if ( 4 == var
+      || k == var
+       )
+      aVariation[ k ]  =  distVariation( gen );
+  return  d7cA::Point<double>( p.x1() + aVariation[ 0 ],
+                               p.x2() + aVariation[ 1 ],
+                               p.x3() + aVariation[ 2 ],
+                               p.x4() + aVariation[ 3 ] );
+}
+
+
+bool
+hasMatch( const d7cA::Point<double>  *arrPoints,
+          const std::size_t&         numPoints,
+          const Query&               query
+        ) noexcept
+{
+  return  nullptr != findSorted( arrPoints, numPoints, query.p, query.tolerance );
+}
+
+
+// a query within the half of the tolerance of the point 'p' along every coordinate:
+static
+d7cA::Point<double>
+makeHit_( const d7cA::Point<double>&  p,
+          const double&               tolerance,
+          std::mt19937&               gen
+        ) noexcept
+{
+  std::uniform_real_distribution<>  distVariation( -0.5 * tolerance, +0.5 * tolerance );
+  const double  x1  =  p.x1() + distVariation( gen );
+  const double  x2  =  p.x2() + distVariation( gen );
+  const double  x3  =  p.x3() + distVariation( gen );
+  const double  x4  =  p.x4() + distVariation( gen );
+  return  d7cA::Point<double>( x1, x2, x3, x4 );
+}
+
+
+// a query next to the point 'p' with no match: one of its coordinates is
+// moved out of the tolerance of 'p', the others stay within it;
+// if a few attempts still match some other point, the query is moved
+// past the largest x1 of the points:
+static
+d7cA::Point<double>
+makeMiss_( const d7cA::Point<double>  *arrPoints,
+           const std::size_t&         numPoints,
+           const d7cA::Point<double>& p,
+           const double&              tolerance,
+           std::mt19937&              gen
+         ) noexcept
+{
+  constexpr unsigned  numAttempts  =  16;
+  std::uniform_int_distribution<>   distCoord( 0, 3 );
+  std::uniform_real_distribution<>  distGap( 0.01, 1.5 );
+  std::bernoulli_distribution       distSign( 0.5 );
+  Query  query;
+  query.tolerance  =  tolerance;
+  for ( unsigned  iAttempt = 0; iAttempt < numAttempts; ++iAttempt )
+  {
+    query.p  =  makeHit_( p, tolerance, gen );
+    double  x[ 4 ]  =  { query.p.x1(), query.p.x2(), query.p.x3(), query.p.x4() };
+    const int  k  =  distCoord( gen );
+    const double  gap  =  1.5 * tolerance + distGap( gen );
+    x[ k ]  =  ( true == distSign( gen ) ) ? x[ k ] + gap : x[ k ] - gap;
+    query.p  =  d7cA::Point<double>( x[ 0 ], x[ 1 ], x[ 2 ], x[ 3 ] );
+    if ( false == hasMatch( arrPoints, numPoints, query ) )
+      return  query.p;
+  }
+  return  d7cA::Point<double>( arrPoints[ numPoints - 1 ].x1() + 2 * tolerance + 1, p.x2(), p.x3(), p.x4() );
+}
+
+
+void
+generateQueries( const Options&              options,
+                 std::mt19937&               gen,
+                 const d7cA::Point<double>   *arrPoints,
+                 const std::size_t&          numPoints,
+                 std::vector<Query>&         queries
+               )
+{
+  std::uniform_real_distribution<>  distTolerance( options.toleranceMin, options.toleranceMax );
+  queries.resize( numPoints );
+
+  // the targets are ranked in a random order, so that the most frequent
+  // targets are not the points of the lowest x1:
+  std::vector<std::size_t>  vecTargets;
+  std::discrete_distribution<std::size_t>  distRank;
+  if ( 0 < options.querySkew )
+  {
+    vecTargets.resize( numPoints );
+    std::iota( vecTargets.begin(), vecTargets.end(), 0 );
+    std::shuffle( vecTargets.begin(), vecTargets.end(), gen );
+    std::vector<double>  vecWeights( numPoints );
+    for ( std::size_t  iRank = 0; iRank < numPoints; ++iRank )
+      vecWeights[ iRank ]  =  1 / std::pow( iRank + 1.0, options.querySkew );
+    distRank  =  std::discrete_distribution<std::size_t>( vecWeights.begin(), vecWeights.end() );
+  }
+
+  for ( std::size_t i = 0; i < numPoints; ++i )
+  {
+    const d7cA::Point<double>&  target  =  arrPoints[ ( 0 < options.querySkew ) ? vecTargets[ distRank( gen ) ] : i ];
+    Query&  query  =  queries[ i ];
+    query.tolerance  =  distTolerance( gen );
+    if ( 0 > options.missRatio )
+    {
+      query.p  =  makeQuery( target, gen );
+      continue;
+    }
+    // the misses are spread evenly over the queries:
+    const bool  isMiss  =  std::floor( ( i + 1 ) * options.missRatio ) > std::floor( i * options.missRatio );
+    query.p  =  ( true == isMiss ) ? makeMiss_( arrPoints, numPoints, target, query.tolerance, gen )
+                                   : makeHit_( target, query.tolerance, gen );
+  }
+}
+
+
+void
+boundingBox( const d7cA::Point<double>  *arrPoints,
+             const std::size_t&         numPoints,
+             double                     (&lo)[ 4 ],
+             double                     (&hi)[ 4 ]
+           ) noexcept
+{
+  for ( unsigned short  k = 0; k < 4; ++k )
+  {
+    lo[ k ]  =  0;
+    hi[ k ]  =  0;
+  }
+  for ( std::size_t i = 0; i < numPoints; ++i )
+  {
+    const double  x[ 4 ]  =  { arrPoints[ i ].x1(), arrPoints[ i ].x2(), arrPoints[ i ].x3(), arrPoints[ i ].x4() };
+    for ( unsigned short  k = 0; k < 4; ++k )
+    {
+      lo[ k ]  =  ( 0 == i ) ? x[ k ] : std::min( lo[ k ], x[ k ] );
+      hi[ k ]  =  ( 0 == i ) ? x[ k ] : std::max( hi[ k ], x[ k ] );
+    }
+  }
+}
+
+} // namespace bench
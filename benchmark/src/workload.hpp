@@ -0,0 +1,79 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+//
+// generators of the points and the queries of the benchmark
+
+
+#ifndef  OCTREE_DIDACTIC_BENCHMARK_WORKLOAD_HPP
+#define  OCTREE_DIDACTIC_BENCHMARK_WORKLOAD_HPP
+
+#include "octree.hpp"
+
+#include "options.hpp"
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace  bench {
+
+// every size has a stream of random numbers of its own,
+// so that a row does not depend on the other sizes requested
+// and all the suites get the same points for the same size:
+void  seedGenerator( std::mt19937&       gen,
+                     const Options&      options,
+                     const std::size_t&  numPoints
+                   );
+
+// fills 'arrPoints' with 'numPoints' points of the 'distribution':
+void  generatePoints( const std::string&     distribution,
+                      std::mt19937&          gen,
+                      d7cA::Point<double> *  arrPoints,
+                      const std::size_t&     numPoints
+                    ) noexcept;
+
+// a query close to the point 'p':
+d7cA::Point<double>  makeQuery( const d7cA::Point<double>&  p,
+                                std::mt19937&               gen
+                              ) noexcept;
+
+// one query of the 'find' suite:
+struct  Query {
+  d7cA::Point<double>  p;
+  double               tolerance;
+};
+
+// fills 'queries' with 'numPoints' queries of the points 'arrPoints'
+// sorted in the 'comparePoints' order:
+// the targets of the queries follow the 'querySkew' of the options,
+// if the 'missRatio' of the options is not negative, that share of the queries
+// has no match and the rest is within the tolerance of its target:
+void  generateQueries( const Options&              options,
+                       std::mt19937&               gen,
+                       const d7cA::Point<double>   *arrPoints,
+                       const std::size_t&          numPoints,
+                       std::vector<Query>&         queries
+                     );
+
+// whether some of the points sorted in the 'comparePoints' order
+// is within the tolerance of the query:
+bool  hasMatch( const d7cA::Point<double>  *arrPoints,
+                const std::size_t&         numPoints,
+                const Query&               query
+              ) noexcept;
+
+// the smallest and the largest coordinates of the points along the axes
+// ( zeros for no points ):
+void  boundingBox( const d7cA::Point<double>  *arrPoints,
+                   const std::size_t&         numPoints,
+                   double                     (&lo)[ 4 ],
+                   double                     (&hi)[ 4 ]
+                 ) noexcept;
+
+} // namespace bench
+
+#endif // OCTREE_DIDACTIC_BENCHMARK_WORKLOAD_HPP
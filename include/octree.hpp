@@ -5,15 +5,65 @@
 // license : GPL.v3+
 
 
+#ifndef  OCTREE_DIDACTIC_OCTREE_HPP
+#define  OCTREE_DIDACTIC_OCTREE_HPP
+
+#include <cassert>
 #include <cstdio>
 #include <cstdint>
+#include <cstddef>
 #include <algorithm>
-#include <typeinfo>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// the nodes ahead of a chain walk of Octree::find() prefetched at every hop
+// ( 0 - none ), set per build, e.g. -DOCTREE_DIDACTIC_PREFETCH=1:
+#ifndef  OCTREE_DIDACTIC_PREFETCH
+#define  OCTREE_DIDACTIC_PREFETCH  0
+#endif
 
 namespace  d7cA {
 
-template<template<class> class  H, class  T>
-class  OctreeObj {
+// the payload stored inline in every node of an Octree<H, T, P, M>, so that
+// the node find() returns carries the data attached to its element
+// ( nothing for P = void, the empty base takes no room in the node ):
+template<class  P>
+struct  OctreePayload {
+  OctreePayload() : payload() { }
+  P  payload;
+};
+
+template<>
+struct  OctreePayload<void> { };
+
+// the multiplicity of the element of a node of an Octree<H, T, P, M>:
+// a counter in the multiset mode ( M = true ), a constant 1 that takes
+// no room in the node otherwise ( a template in C as well, so that
+// the constant is defined in this header ):
+template<bool  M, class  C = unsigned long>
+struct  OctreeCount {
+  OctreeCount() : count( 1 ) { }
+  C  count;
+};
+
+template<class  C>
+struct  OctreeCount<false, C> {
+  static const C  count  =  1;
+};
+
+template<class  C>
+const C  OctreeCount<false, C>::count;
+
+
+template<template<class> class  H, class  T, class  P = void, bool  M = false>
+class  OctreeObj : public OctreePayload<P>,
+                   public OctreeCount<M> {
   public:
     OctreeObj() : info(),
                   north( nullptr ),
@@ -25,6 +75,12 @@ class  OctreeObj {
 		  sw( nullptr ),
 		  se( nullptr )
     { }
+    // the links indexed in the order of the ordered traversal:
+    // 0 - south, 1 - east, 2 - se, 3 - ne, 4 - sw, 5 - nw, 6 - west, 7 - north
+    // ( the links 0..3 lead to 'smaller' elements, the links 4..7 to 'larger' ones;
+    //   the link opposite to the link 'i' is the link '7 - i' ):
+    OctreeObj *&  link( const unsigned short  i ) noexcept;
+    OctreeObj *  link( const unsigned short  i ) const noexcept;
   public:
     H<T>       info;
     OctreeObj  *north;
@@ -38,549 +94,2157 @@ class  OctreeObj {
 };
 
 
-template<template<class> class  H, class T>
+template<template<class> class  H, class  T, class  P, bool  M>
+OctreeObj<H, T, P, M> *&
+OctreeObj<H, T, P, M>::link( const unsigned short  i ) noexcept
+{
+  switch ( i )
+  {
+    case 0:  return  south;
+    case 1:  return  east;
+    case 2:  return  se;
+    case 3:  return  ne;
+    case 4:  return  sw;
+    case 5:  return  nw;
+    case 6:  return  west;
+    default: return  north;
+  }
+}
+
+
+template<template<class> class  H, class  T, class  P, bool  M>
+OctreeObj<H, T, P, M> *
+OctreeObj<H, T, P, M>::link( const unsigned short  i ) const noexcept
+{
+  return  const_cast<OctreeObj<H, T, P, M> *>( this )->link( i );
+}
+
+
+// the path from the root of a tree to one of its nodes
+// stored as runs of hops along the same link;
+// a path consists of at most 5 runs: insert() walks from the root along
+// N/S, W/E, NW/SE and SW/NE in this order ( a walk that turns back along
+// the same pair merely shortens its run ), so a node it reaches is at most
+// one run per chain level away, and the node it attaches by a single link
+// adds one run more ( a node attached off that order is never reached by
+// a later walk, hence never gets nodes attached to it ); merge() zips the
+// chains level by level and a node keeps both its level and the nodes
+// attached to it, balance_() and split() move the root along its
+// North-South chain, which lengthens or shortens the first run only,
+// and clone() and relayout() copy the links as they are:
+template<class  N>
+class  OctreePath {
+  public:
+    OctreePath() noexcept;
+    bool  isAtRoot() const noexcept;
+    // the link of the current node that leads to its parent
+    // ( 8 at the root ):
+    unsigned short  parentLink() const noexcept;
+    // moves 'pNode' to its neighbour along the link 'iLink'
+    // ( asserts the bound on the number of runs above ):
+    void  descend( N *&  pNode, const unsigned short  iLink ) noexcept;
+    // moves 'pNode' to its parent,
+    // returns the link the parent had been left by:
+    unsigned short  ascend( N *&  pNode ) noexcept;
+  private:
+    struct  Frame_ {
+      N               *pStart;
+      unsigned short  iLink;
+    };
+    static constexpr unsigned short  maxNumFrames_  =  5;
+    Frame_          frames_[ maxNumFrames_ ];
+    unsigned short  numFrames_;
+};
+
+
+template<class  N>
+OctreePath<N>::OctreePath() noexcept : frames_(), numFrames_( 0 ) { }
+
+
+template<class  N>
+bool
+OctreePath<N>::isAtRoot() const noexcept
+{
+  return  0 == numFrames_;
+}
+
+
+template<class  N>
+unsigned short
+OctreePath<N>::parentLink() const noexcept
+{
+  if ( 0 == numFrames_ )
+    return  8;
+  return  7 - frames_[ numFrames_ - 1 ].iLink;
+}
+
+
+template<class  N>
+void
+OctreePath<N>::descend( N *&  pNode, const unsigned short  iLink ) noexcept
+{
+  if ( 0 == numFrames_
+    || iLink != frames_[ numFrames_ - 1 ].iLink
+     )
+  {
+    assert( maxNumFrames_ > numFrames_ );
+    frames_[ numFrames_ ].pStart  =  pNode;
+    frames_[ numFrames_ ].iLink  =  iLink;
+    ++numFrames_;
+  }
+  pNode  =  pNode->link( iLink );
+}
+
+
+template<class  N>
+unsigned short
+OctreePath<N>::ascend( N *&  pNode ) noexcept
+{
+  const unsigned short  iLink  =  frames_[ numFrames_ - 1 ].iLink;
+  pNode  =  pNode->link( 7 - iLink );
+  if ( pNode == frames_[ numFrames_ - 1 ].pStart )
+    --numFrames_;
+  return  iLink;
+}
+
+
+// forward iterator over all the elements of an Octree
+// ( neither recursion nor heap allocation is involved );
+// the elements of a tree built by Octree::init() are visited in the
+// 'comparePoints' order, while a tree grown by arbitrary Octree::insert()
+// calls may contain nodes attached off their chains, such nodes are
+// visited next to the nodes they are attached to:
+template<template<class> class  H, class  T, class  P, bool  M>
+class  OctreeIterator {
+  public:
+    typedef  std::forward_iterator_tag      iterator_category;
+    typedef  OctreeObj<H, T, P, M>          value_type;
+    typedef  std::ptrdiff_t                 difference_type;
+    typedef  const OctreeObj<H, T, P, M> *  pointer;
+    typedef  const OctreeObj<H, T, P, M> &  reference;
+  public:
+    // past-the-end iterator:
+    OctreeIterator() noexcept;
+    // iterator to the first element of the tree with the root 'pRoot':
+    explicit OctreeIterator( const OctreeObj<H, T, P, M> * const  pRoot ) noexcept;
+    reference  operator*() const noexcept;
+    pointer  operator->() const noexcept;
+    OctreeIterator&  operator++() noexcept;
+    OctreeIterator  operator++( int ) noexcept;
+    friend bool  operator==( const OctreeIterator&  a, const OctreeIterator&  b ) noexcept
+    {
+      return  a.pNode_ == b.pNode_;
+    }
+    friend bool  operator!=( const OctreeIterator&  a, const OctreeIterator&  b ) noexcept
+    {
+      return  a.pNode_ != b.pNode_;
+    }
+  private:
+    void  advance_() noexcept;
+  private:
+    OctreePath<const OctreeObj<H, T, P, M> >  path_;
+    const OctreeObj<H, T, P, M>               *pNode_;
+    // the traversal state of 'pNode_': 0..3 - the links 0..3 are next,
+    // 4 - 'pNode_' itself is next, 5..8 - the links 4..7 are next,
+    // 9 - all the links of 'pNode_' have been visited:
+    unsigned short                            iNext_;
+};
+
+
+template<template<class> class  H, class  T, class  P, bool  M>
+OctreeIterator<H, T, P, M>::OctreeIterator() noexcept : path_(),
+                                                        pNode_( nullptr ),
+                                                        iNext_( 0 )
+{ }
+
+
+template<template<class> class  H, class  T, class  P, bool  M>
+OctreeIterator<H, T, P, M>::OctreeIterator( const OctreeObj<H, T, P, M> * const  pRoot ) noexcept : path_(),
+                                                                                                   pNode_( pRoot ),
+                                                                                                   iNext_( 0 )
+{
+  advance_();
+}
+
+
+template<template<class> class  H, class  T, class  P, bool  M>
+typename OctreeIterator<H, T, P, M>::reference
+OctreeIterator<H, T, P, M>::operator*() const noexcept
+{
+  return  *pNode_;
+}
+
+
+template<template<class> class  H, class  T, class  P, bool  M>
+typename OctreeIterator<H, T, P, M>::pointer
+OctreeIterator<H, T, P, M>::operator->() const noexcept
+{
+  return  pNode_;
+}
+
+
+template<template<class> class  H, class  T, class  P, bool  M>
+OctreeIterator<H, T, P, M>&
+OctreeIterator<H, T, P, M>::operator++() noexcept
+{
+  advance_();
+  return  *this;
+}
+
+
+template<template<class> class  H, class  T, class  P, bool  M>
+OctreeIterator<H, T, P, M>
+OctreeIterator<H, T, P, M>::operator++( int ) noexcept
+{
+  OctreeIterator<H, T, P, M>  tmp( *this );
+  advance_();
+  return  tmp;
+}
+
+
+template<template<class> class  H, class  T, class  P, bool  M>
+void
+OctreeIterator<H, T, P, M>::advance_() noexcept
+{
+  while ( nullptr != pNode_ )
+  {
+    if ( 4 == iNext_ )
+    {
+      iNext_  =  5;
+      return;
+    }
+    if ( 9 > iNext_ )
+    {
+      const unsigned short  iLink  =  ( 4 > iNext_ ) ? iNext_ : iNext_ - 1;
+      ++iNext_;
+      if ( nullptr == pNode_->link( iLink )
+        || path_.parentLink() == iLink
+         )
+        continue;
+      path_.descend( pNode_, iLink );
+      iNext_  =  0;
+      continue;
+    }
+    // all the links of 'pNode_' have been visited, go back to its parent:
+    if ( true == path_.isAtRoot() )
+    {
+      pNode_  =  nullptr;
+      return;
+    }
+    const unsigned short  iLink  =  path_.ascend( pNode_ );
+    iNext_  =  ( 4 > iLink ) ? iLink + 1 : iLink + 2;
+  }
+}
+
+
+// a block of nodes allocated at once ( see Octree::clone() );
+// the nodes of a block are not deleted one by one, the whole block
+// is released by the last tree that refers to it:
+template<template<class> class  H, class  T, class  P, bool  M>
+struct  OctreeArena {
+  OctreeObj<H, T, P, M>  *nodes;
+  std::size_t            numNodes;
+  unsigned long          numRefs;
+};
+
+
+// the statistics of Octree::find() calls, accumulated over all the calls
+// the same object is passed to:
+struct  QueryStats {
+  QueryStats() noexcept : numHops(),
+                          numPredicates( 0 ),
+                          numCalls( 0 ),
+                          depth( 0 ),
+                          maxDepth( 0 ),
+                          numNodesTouched( 0 )
+  { }
+  // the hops along the chains, per direction pair:
+  // 0 - N/S, 1 - W/E, 2 - NW/SE, 3 - SW/NE:
+  std::size_t  numHops[ 4 ];
+  // the evaluations of the tolerance predicate:
+  std::size_t  numPredicates;
+  // the calls of find() including its restarts at the ends
+  // of its walks along the North-South chain:
+  std::size_t  numCalls;
+  // the current and the deepest nesting of find() ( 1 - no restart ):
+  std::size_t  depth;
+  std::size_t  maxDepth;
+  // the starting node of every call plus the node reached by every hop:
+  std::size_t  numNodesTouched;
+
+  std::size_t  getNumHops() const noexcept
+  {
+    return  numHops[ 0 ] + numHops[ 1 ] + numHops[ 2 ] + numHops[ 3 ];
+  }
+  void  hop( const unsigned short  iPair ) noexcept
+  {
+    ++numHops[ iPair ];
+    ++numNodesTouched;
+  }
+  void  predicate() noexcept
+  {
+    ++numPredicates;
+  }
+  void  enter() noexcept
+  {
+    ++numCalls;
+    ++numNodesTouched;
+    ++depth;
+    if ( maxDepth < depth )
+      maxDepth  =  depth;
+  }
+  void  leave() noexcept
+  {
+    --depth;
+  }
+};
+
+
+// the policy that collects no statistics at all
+// ( every call compiles away ):
+struct  NoQueryStats {
+  void  hop( const unsigned short ) noexcept { }
+  void  predicate() noexcept { }
+  void  enter() noexcept { }
+  void  leave() noexcept { }
+};
+
+
+// the policy behind the legacy 'numOperations' counter of Octree::find(),
+// it counts the hops only:
+class  OperationCounter {
+  public:
+    explicit OperationCounter( std::size_t&  numOperations ) noexcept : numOperations_( numOperations ) { }
+    void  hop( const unsigned short ) noexcept { ++numOperations_; }
+    void  predicate() noexcept { }
+    void  enter() noexcept { }
+    void  leave() noexcept { }
+  private:
+    std::size_t  &numOperations_;
+};
+
+
+// the order of the nodes in memory after Octree::relayout():
+// 'depthFirst' - the order of a depth-first walk of the tree ( as Octree::clone() ),
+// 'chains' - every chain is contiguous, from its 'smaller' end to its 'larger' one,
+// and the chains follow each other breadth-first from the North-South one,
+// so that the hops of Octree::find() along a chain go to the adjacent nodes:
+enum class  OctreeLayout { depthFirst, chains };
+
+
+// the comparisons of the coordinates of type T against a tolerance, chosen
+// at compile time: isNegative( t ) is false for an unsigned T,
+// isWithin( a, b, t ) is |a - b| <= t for t >= 0, for an integral T
+// the difference is taken in the unsigned type and never overflows:
+template<class  T, bool  isIntegral = std::is_integral<T>::value>
+struct  ToleranceCheck {
+  static bool  isNegative( const T&  t ) noexcept
+  {
+    return  0 > t;
+  }
+  static bool  isWithin( const T&  a, const T&  b, const T&  t ) noexcept
+  {
+    return  t >= std::abs( a - b );
+  }
+};
+
+template<class  T>
+struct  ToleranceCheck<T, true> {
+  typedef  typename std::make_unsigned<T>::type  U;
+  static bool  isNegative( const T&  t ) noexcept
+  {
+    return  isNegative_( t, std::is_signed<T>() );
+  }
+  static bool  isWithin( const T&  a, const T&  b, const T&  t ) noexcept
+  {
+    const U  d  =  ( a < b ) ? static_cast<U>( static_cast<U>( b ) - static_cast<U>( a ) )
+                             : static_cast<U>( static_cast<U>( a ) - static_cast<U>( b ) );
+    return  static_cast<U>( t ) >= d;
+  }
+  private:
+    static bool  isNegative_( const T&  t, std::true_type ) noexcept
+    {
+      return  T( 0 ) > t;
+    }
+    static bool  isNegative_( const T&, std::false_type ) noexcept
+    {
+      return  false;
+    }
+};
+
+
+// the order of the elements along the chains of the tree, used by Octree::insert():
+// isSamePrefix<N>( a, b ) - 'a' and 'b' share their first N coordinates,
+// isNotLess<N>( a, b ) - they share the first N-1 coordinates and a.xN >= b.xN,
+// isLess<N>( a, b ) - they share the first N-1 coordinates and a.xN < b.xN;
+// an element type with a cheaper order may specialize it ( see PackedPoint ):
+template<template<class> class  H, class  T>
+struct  PointOrder {
+  template<unsigned short  N>
+  static bool  isSamePrefix( const H<T>&  a, const H<T>&  b ) noexcept
+  {
+    return  ( N < 1 || a.x1() == b.x1() )
+         && ( N < 2 || a.x2() == b.x2() )
+         && ( N < 3 || a.x3() == b.x3() )
+         && ( N < 4 || a.x4() == b.x4() );
+  }
+  template<unsigned short  N>
+  static bool  isNotLess( const H<T>&  a, const H<T>&  b ) noexcept
+  {
+    return  coordinate( a, N ) >= coordinate( b, N ) && isSamePrefix<N - 1>( a, b );
+  }
+  template<unsigned short  N>
+  static bool  isLess( const H<T>&  a, const H<T>&  b ) noexcept
+  {
+    return  coordinate( a, N ) < coordinate( b, N ) && isSamePrefix<N - 1>( a, b );
+  }
+  // the coordinate 'n' ( 1 - x1, ..., 4 - x4 ):
+  static T  coordinate( const H<T>&  a, const unsigned short  n ) noexcept
+  {
+    if ( 1 == n )  return  a.x1();
+    if ( 2 == n )  return  a.x2();
+    if ( 3 == n )  return  a.x3();
+    return  a.x4();
+  }
+};
+
+
+// the shape of an Octree ( see Octree::stats() ):
+struct  OctreeStats {
+  OctreeStats() noexcept : numNodes( 0 ),
+                           numElements( 0 ),
+                           numBytes( 0 ),
+                           numIndexBytes( 0 ),
+                           numChains(),
+                           maxChainLength(),
+                           sumChainLength(),
+                           chainLengths(),
+                           distanceToSouth( 0 ),
+                           distanceToNorth( 0 ),
+                           maxDepth( 0 ),
+                           meanDepth( 0. ),
+                           balance( 1. )
+  { }
+  static constexpr unsigned short  numBins  =  64;
+  std::size_t  numNodes;
+  std::size_t  numElements;
+  // the memory held by the tree: the tree itself, the nodes allocated
+  // one by one and the whole arenas the tree refers to:
+  std::size_t  numBytes;
+  // the part of 'numBytes' held by the hash index ( 0 without one ):
+  std::size_t  numIndexBytes;
+  // the chains of at least two nodes per direction pair
+  // 0 - N/S, 1 - W/E, 2 - NW/SE, 3 - SW/NE:
+  std::size_t  numChains[ 4 ];
+  std::size_t  maxChainLength[ 4 ];
+  std::size_t  sumChainLength[ 4 ];
+  // the histograms of the chain lengths: the bin 'b' counts the chains
+  // of '2^b' to '2^(b+1) - 1' nodes:
+  std::size_t  chainLengths[ 4 ][ numBins ];
+  // the hops from the root to the ends of the North-South chain:
+  std::size_t  distanceToSouth;
+  std::size_t  distanceToNorth;
+  // the hops from the root to the farthest node and their average over all nodes:
+  std::size_t  maxDepth;
+  double       meanDepth;
+  // 1 if the root is in the middle of the North-South chain,
+  // 0 if it is at one of its ends:
+  double       balance;
+};
+
+
+// an open-addressing hash table from the coordinates of the elements to their
+// nodes ( linear probing, at most half full ), see Octree::setHashIndex();
+// the coordinates are hashed by std::hash<T>, so that the elements equal
+// as numbers ( such as 0. and -0. ) share their hash:
+template<template<class> class  H, class  T, class  P, bool  M>
+class  OctreeHashIndex {
+  public:
+    OctreeHashIndex() noexcept;
+    // adds the node 'p' unless an element equal to its one is indexed already:
+    void  insert( OctreeObj<H, T, P, M> * const  p );
+    // the node of the element equal to 'ob' ( nullptr if none ):
+    OctreeObj<H, T, P, M> *  find( const H<T>&  ob ) const noexcept;
+    void  clear() noexcept;
+    // the memory held by the table:
+    std::size_t  getNumBytes() const noexcept;
+  private:
+    struct  Slot_ {
+      std::size_t            hash;
+      OctreeObj<H, T, P, M>  *p;
+    };
+    static std::size_t  hash_( const H<T>&  ob ) noexcept;
+    void  insert_( const Slot_&  slot ) noexcept;
+  private:
+    std::vector<Slot_>  slots_;
+    std::size_t         numUsed_;
+};
+
+
+template<template<class> class  H, class  T, class  P, bool  M>
+OctreeHashIndex<H, T, P, M>::OctreeHashIndex() noexcept : slots_(),
+                                                          numUsed_( 0 )
+{ }
+
+
+template<template<class> class  H, class  T, class  P, bool  M>
+std::size_t
+OctreeHashIndex<H, T, P, M>::hash_( const H<T>&  ob ) noexcept
+{
+  const std::hash<T>  hash;
+  std::uint64_t  h  =  hash( ob.x1() );
+  h  =  ( h ^ hash( ob.x2() ) ) * 0x9e3779b97f4a7c15ULL;
+  h  =  ( h ^ hash( ob.x3() ) ) * 0x9e3779b97f4a7c15ULL;
+  h  =  ( h ^ hash( ob.x4() ) ) * 0x9e3779b97f4a7c15ULL;
+  // the high bits are folded into the low ones, which pick the slot:
+  return  static_cast<std::size_t>( h ^ ( h >> 29 ) ^ ( h >> 47 ) );
+}
+
+
+template<template<class> class  H, class  T, class  P, bool  M>
+void
+OctreeHashIndex<H, T, P, M>::insert_( const Slot_&  slot ) noexcept
+{
+  const std::size_t  mask  =  slots_.size() - 1;
+  std::size_t  i  =  slot.hash & mask;
+  while ( nullptr != slots_[ i ].p )
+    i  =  ( i + 1 ) & mask;
+  slots_[ i ]  =  slot;
+}
+
+
+template<template<class> class  H, class  T, class  P, bool  M>
+void
+OctreeHashIndex<H, T, P, M>::insert( OctreeObj<H, T, P, M> * const  p )
+{
+  if ( nullptr != find( p->info ) )
+    return;
+  if ( 2 * ( numUsed_ + 1 ) > slots_.size() )
+  {
+    // the table is doubled and refilled:
+    std::vector<Slot_>  vecOld( std::max<std::size_t>( 16, 2 * slots_.size() ) );
+    vecOld.swap( slots_ );
+    for ( const Slot_&  slot : vecOld )
+      if ( nullptr != slot.p )
+        insert_( slot );
+  }
+  Slot_  slot;
+  slot.hash  =  hash_( p->info );
+  slot.p  =  p;
+  insert_( slot );
+  ++numUsed_;
+}
+
+
+template<template<class> class  H, class  T, class  P, bool  M>
+OctreeObj<H, T, P, M> *
+OctreeHashIndex<H, T, P, M>::find( const H<T>&  ob ) const noexcept
+{
+  if ( 0 == numUsed_ )
+    return  nullptr;
+  const std::size_t  hash  =  hash_( ob );
+  const std::size_t  mask  =  slots_.size() - 1;
+  for ( std::size_t  i = hash & mask; nullptr != slots_[ i ].p; i = ( i + 1 ) & mask )
+    if ( hash == slots_[ i ].hash
+      && true == PointOrder<H, T>::template isSamePrefix<4>( ob, slots_[ i ].p->info )
+       )
+      return  slots_[ i ].p;
+  return  nullptr;
+}
+
+
+template<template<class> class  H, class  T, class  P, bool  M>
+void
+OctreeHashIndex<H, T, P, M>::clear() noexcept
+{
+  std::vector<Slot_>().swap( slots_ );
+  numUsed_  =  0;
+}
+
+
+template<template<class> class  H, class  T, class  P, bool  M>
+std::size_t
+OctreeHashIndex<H, T, P, M>::getNumBytes() const noexcept
+{
+  return  sizeof( *this ) + slots_.capacity() * sizeof( Slot_ );
+}
+
+
+// a hook into the private members of an Octree for the unit tests
+// and the benchmark: the library defines no specialization of it,
+// a test declares its own 'template<> class OctreeAccess<Tag>'
+// to call the private traversal routines in isolation:
+template<class  Tag>
+class  OctreeAccess;
+
+
+template<template<class> class  H, class T, class  P = void, bool  M = false>
 class  Octree {
+    template<class  Tag>
+    friend class  OctreeAccess;
   public:
     Octree();
+    // the moved-from tree is left empty:
+    Octree( Octree&&  that ) noexcept;
+    Octree<H, T, P, M>&  operator=( Octree<H, T, P, M>&&  that ) noexcept;
+    void  swap( Octree<H, T, P, M>&  that ) noexcept;
+    friend void  swap( Octree<H, T, P, M>&  a, Octree<H, T, P, M>&  b ) noexcept
+    {
+      a.swap( b );
+    }
+    // a deep copy of the tree, its nodes are placed into a single arena
+    // in the order of a depth-first walk of the tree:
+    Octree<H, T, P, M>  clone() const;
+    // moves all the nodes into a single new arena in the order of 'layout'
+    // and rewrites the links to match ( the shape of the tree is kept,
+    // the pointers to the nodes are invalidated ):
+    void  relayout( const OctreeLayout  layout = OctreeLayout::chains );
+    // moves all the elements of 'that' into '*this' without reallocating
+    // the nodes, the sorted chains of both trees are zipped together
+    // in time linear in the combined size ( 'that' is left empty; a duplicate
+    // of the multiset mode merged into a node of '*this' leaves its payload behind ):
+    void  merge( Octree<H, T, P, M>&&  that ) noexcept;
+    // moves all the elements with 'x1 >= pivot' into the returned tree:
+    // the North-South chain is severed at the pivot, the nodes are neither
+    // copied nor reallocated ( the arenas are shared by both trees ); the cost
+    // is not local to the pivot though: the sizes of both halves are recounted
+    // by walking all the nodes of the smaller one, both halves are rebalanced
+    // by walking their North-South chains, and a hash index ( if any ) is rebuilt
+    // over all the nodes, i.e. O( n ) with an index and O( min( n1, n2 ) + chain ) without:
+    Octree<H, T, P, M>  split( const T&  pivot );
     void  init( H<T> * const  arr, const long&  num, bool (*foo)( const H<T>&, const H<T>& ) ) noexcept;
+    // the same for a tree with a payload: 'payloads[ i ]' is stored together
+    // with 'arr[ i ]' ( 'arr' is not reordered, an index is sorted instead ):
+    template<class  Q>
+    void  init( const H<T> * const  arr,
+                const Q * const     payloads,
+                const long&         num,
+                bool (*foo)( const H<T>&, const H<T>& )
+              );
     void  insert( const H<T>&  obj ) noexcept;
+    // the same for a tree with a payload: the node holding 'obj' gets a copy
+    // of 'payload' ( in the multiset mode the payload of an equal element
+    // stored already is overwritten ) and is returned ( nullptr if 'obj'
+    // was dropped ); a template, so that a tree with P = void has no such call:
+    template<class  Q>
+    OctreeObj<H, T, P, M> *  insert( const H<T>&  obj, const Q&  payload );
+    // keeps ( true ) or drops ( false ) a hash index of the elements, so that
+    // find() with a tolerance of 0 and no start node is a single probe;
+    // the index is built from the elements stored and kept up to date by
+    // insert(), merge(), split() and relayout() ( a clone() has none );
+    // it finds every element stored, even one the traversal of a tree grown
+    // by arbitrary insert() would miss; should one of those calls fail to grow
+    // the index it drops the index instead of throwing, so that hasHashIndex()
+    // turns false and find() traverses the tree again ( setHashIndex( true )
+    // itself throws std::bad_alloc ):
+    void  setHashIndex( const bool  isIndexed );
+    bool  hasHashIndex() const noexcept;
     ~Octree();
     const unsigned long&  getNumElements() const noexcept;
+    // the number of nodes ( less than the number of elements
+    // if the multiset mode merged some duplicates ):
+    const unsigned long&  getNumNodes() const noexcept;
+    // in the multiset mode ( M = true ) an element equal to an already stored one
+    // increments the 'count' of the stored node instead of being inserted
+    // as a separate node ( the nodes of a set hold no count ):
+    bool  isMultiset() const noexcept;
+    // walks the whole tree to describe its shape:
+    OctreeStats  stats() const noexcept;
+    // iteration over all the elements in the 'comparePoints' order:
+    typedef  OctreeIterator<H, T, P, M>  const_iterator;
+    const_iterator  begin() const noexcept;
+    const_iterator  end() const noexcept;
 //    const H<T>&  getClosest( const Octree&, const T& ) const;
-    OctreeObj<H, T> *  find( const H<T>&              ob,
-                             std::size_t&             numOperations,
-                             const T&                 tolerance = 0,
-                             OctreeObj<H, T> * const  p = nullptr
-                           ) const noexcept;
+    OctreeObj<H, T, P, M> *  find( const H<T>&                    ob,
+                                   std::size_t&                   numOperations,
+                                   const T&                       tolerance = 0,
+                                   OctreeObj<H, T, P, M> * const  p = nullptr
+                                 ) const noexcept;
+    // the same search reporting its traversal to a statistics policy 'S'
+    // ( QueryStats, NoQueryStats or any class with the same members ):
+    template<class  S>
+    OctreeObj<H, T, P, M> *  find( const H<T>&                    ob,
+                                   S&                             stats,
+                                   const T&                       tolerance = 0,
+                                   OctreeObj<H, T, P, M> * const  p = nullptr
+                                 ) const noexcept;
+    // looks for 'num' elements at once: 'results[ i ]' is what
+    // find( obs[ i ], stats, tolerances[ i ] ) returns; up to 'G' queries
+    // walk the North-South chain of the root in turns, one hop each,
+    // and every hop prefetches the next node of its walk, so that
+    // the cache misses of the queries overlap ( the lower levels
+    // are searched by find() as soon as a walk reaches them ):
+    template<std::size_t  G = 8>
+    void  findBatch( const H<T> * const              obs,
+                     const T * const                 tolerances,
+                     const std::size_t&              num,
+                     OctreeObj<H, T, P, M> ** const  results
+                   ) const noexcept;
+    // the number of elements within 'tolerance' of 'ob' along every axis
+    // ( the 'count' of every such node is added up, nothing is returned
+    //   but the sum ): the North-South chain is searched for the x1 window
+    // as find() does, and every slice in it ( a node of the chain together
+    // with all the nodes below it ) lying entirely within the tolerance adds
+    // its count at once; the counts and the extents of the slices are cached
+    // by the first call after a change of the tree ( const calls, this one
+    // included, may run concurrently on a tree, a call that changes the tree
+    // may not run alongside any other call ):
+    std::size_t  countWithin( const H<T>&  ob, const T&  tolerance ) const;
   private:
     // copy-ctor and assignment operator are not allowed:
     Octree( const Octree& );
-    Octree<H, T>&  operator=( const Octree<H, T>& );
+    Octree<H, T, P, M>&  operator=( const Octree<H, T, P, M>& );
   private:
-    bool  checkEndNode_( const OctreeObj<H, T> * const ) const noexcept;
+    struct  ArenaRef_ {
+      OctreeArena<H, T, P, M>  *pArena;
+      ArenaRef_                *next;
+    };
+    // reports the entry to and the exit from a find() call:
+    template<class  S>
+    struct  StatsScope_ {
+      explicit StatsScope_( S&  s ) noexcept : stats( s ) { stats.enter(); }
+      ~StatsScope_() { stats.leave(); }
+      S  &stats;
+    };
+    // a query of findBatch() suspended between two hops along
+    // the North-South chain of the root:
+    struct  BatchQuery_ {
+      const H<T>             *ob;
+      T                      tolerance;
+      std::size_t            iQuery;
+      OctreeObj<H, T, P, M>  *pTmp;
+      // 0 - the walk to the south, 7 - the walk to the north:
+      unsigned short         iLink;
+      // an exact query walks towards its x1 only ( see findExact_() ):
+      bool                   isExact;
+    };
+    // a node of the North-South chain with the number of elements
+    // and the extents of x2, x3, x4 of its slice:
+    struct  Slice_ {
+      const OctreeObj<H, T, P, M>  *p;
+      T                            x1;
+      std::size_t                  count;
+      T                            lo[ 3 ];
+      T                            hi[ 3 ];
+    };
+    // both return true once 'results[ query.iQuery ]' is set:
+    bool  startBatchQuery_( BatchQuery_&  query, OctreeObj<H, T, P, M> ** const  results ) const noexcept;
+    bool  stepBatchQuery_( BatchQuery_&  query, OctreeObj<H, T, P, M> ** const  results ) const noexcept;
+    // inserts 'obj' and returns the node holding it
+    // ( nullptr if no chain end could take it ):
+    OctreeObj<H, T, P, M> *  insert_( const H<T>&  obj ) noexcept;
+    // refills the hash index ( if any ) with all the nodes of the tree:
+    void  rebuildHashIndex_() noexcept;
+    // adds the node 'p' to the hash index ( if any ):
+    void  indexNode_( OctreeObj<H, T, P, M> * const  p ) noexcept;
+    // drops an index that failed to grow, so that find() falls back to the traversal:
+    void  dropHashIndex_() noexcept;
+    // copies the element of 'from', its count and its payload ( not the links ):
+    static void  copyElement_( OctreeObj<H, T, P, M>&  to, const OctreeObj<H, T, P, M>&  from );
+    // refills 'slices_' from the South end of the North-South chain to its North end:
+    void  rebuildSlices_() const;
+    // calls 'visit( q )' for every node 'q' of the slice of 'pSlice' in a depth-first
+    // walk that does not follow the link 'iLink' of 'q' if 'isPruned( q, iLink )':
+    template<class  V, class  F>
+    void  walkSlice_( const OctreeObj<H, T, P, M> * const  pSlice, V&  visit, F&  isPruned ) const noexcept;
+    // split() that adds the number of the nodes it visits to 'numVisited':
+    Octree<H, T, P, M>  split_( const T&  pivot, std::size_t&  numVisited );
+    bool  isInArena_( const OctreeObj<H, T, P, M> * const  p ) const noexcept;
+    void  releaseNode_( OctreeObj<H, T, P, M> * const  p ) noexcept;
+    void  releaseArenas_() noexcept;
+    static T  coordinate_( const H<T>&  ob, const unsigned short  i ) noexcept;
+    static bool  isWithin_( const T&  a, const T&  b, const T&  tolerance ) noexcept;
+    // whether the walk from 'p' along the North-South link 'iLink' has passed
+    // the x1 of 'ob' ( the chain is sorted by x1, north is greater ):
+    static bool  isPastX1_( const H<T>&  ob, const OctreeObj<H, T, P, M> * const  p, const unsigned short  iLink ) noexcept;
+    // prefetches the next OCTREE_DIDACTIC_PREFETCH nodes along the link 'iLink' of 'p':
+    static void  prefetch_( const OctreeObj<H, T, P, M> *  p, const unsigned short  iLink ) noexcept;
+    // the first and the last cache lines of the node 'p' ( if any ):
+    static void  prefetchNode_( const OctreeObj<H, T, P, M> * const  p ) noexcept;
+    // returns the number of the hops it takes along the North-South chain:
+    std::size_t  balance_() noexcept;
+    void  mergeChains_( const unsigned short     level,
+                        OctreeObj<H, T, P, M> *  pA,
+                        OctreeObj<H, T, P, M> *  pB
+                      ) noexcept;
+    // adds 'num' to the count of 'to' ( a set never gets there, its nodes hold no count ):
+    static void  addCount_( OctreeObj<H, T, P, M>&  to, const unsigned long  num, std::true_type ) noexcept
+    {
+      to.count  +=  num;
+    }
+    static void  addCount_( OctreeObj<H, T, P, M>&, const unsigned long, std::false_type ) noexcept
+    { }
+    bool  checkEndNode_( const OctreeObj<H, T, P, M> * const ) const noexcept;
     void  getRootToEndNode_() noexcept;
     void  deleteEndNodes_() noexcept;
-    void  print_( OctreeObj<H, T> *  p = nullptr ) const noexcept;
-    bool  isWithinTolerance_( const H<T>&              ob,
-                              const T&                 tolerance,
-                              OctreeObj<H, T> * const  pTmp
+    void  print_( OctreeObj<H, T, P, M> *  p = nullptr ) const noexcept;
+    template<class  S>
+    bool  isWithinTolerance_( const H<T>&                    ob,
+                              const T&                       tolerance,
+                              OctreeObj<H, T, P, M> * const  pTmp,
+                              S&                             stats
                             ) const noexcept;
-    OctreeObj<H, T> *  moveAlongWestEast_( const H<T>&,
-                                           const T&,
-                                           OctreeObj<H, T> * const,
-                                           std::size_t&
-                                         ) const noexcept;
-    OctreeObj<H, T> *  moveAlongNWSE_( const H<T>&,
-                                       const T&,
-                                       OctreeObj<H, T> * const,
-                                       std::size_t&
-                                     ) const noexcept;   
-    OctreeObj<H, T> *  moveAlongSWNE_( const H<T>&,
-                                       const T&,
-                                       OctreeObj<H, T> * const,
-                                       std::size_t&
-                                     ) const noexcept;
-    OctreeObj<H, T> *  findIn_NWSE_SWNE_( const H<T>&              ob,
-                                          std::size_t&             numOperations,
-                                          const T&                 tolerance,
-                                          OctreeObj<H, T> * const  pInit
-                                        ) const noexcept;
-    OctreeObj<H, T> *  findIn_WestEast_NWSE_SWNE_( const H<T>&              ob,
-                                                   std::size_t&             numOperations,
-                                                   const T&                 tolerance,
-                                                   OctreeObj<H, T> * const  pInit
-                                                 ) const noexcept;
+    // the same for a tolerance of 0, compared by PointOrder:
+    template<class  S>
+    bool  isSameElement_( const H<T>&                          ob,
+                          const OctreeObj<H, T, P, M> * const  pTmp,
+                          S&                                   stats
+                        ) const noexcept;
+    template<class  S>
+    OctreeObj<H, T, P, M> *  moveAlongWestEast_( const H<T>&,
+                                                 const T&,
+                                                 OctreeObj<H, T, P, M> * const,
+                                                 S&
+                                               ) const noexcept;
+    template<class  S>
+    OctreeObj<H, T, P, M> *  moveAlongNWSE_( const H<T>&,
+                                             const T&,
+                                             OctreeObj<H, T, P, M> * const,
+                                             S&
+                                           ) const noexcept;   
+    template<class  S>
+    OctreeObj<H, T, P, M> *  moveAlongSWNE_( const H<T>&,
+                                             const T&,
+                                             OctreeObj<H, T, P, M> * const,
+                                             S&
+                                           ) const noexcept;
+    // the search of find() for 'ob' itself ( tolerance 0 ) from a node 'pInit',
+    // it walks along the North-South chain towards the x1 of 'ob' only and stops
+    // as soon as it reaches or passes it; the elements and their x1 are compared
+    // by PointOrder ( e.g. by the keys of PackedPoint ), the walk within the slice
+    // of that x1 compares the coordinates as a tolerance of 0 does:
+    template<class  S>
+    OctreeObj<H, T, P, M> *  findExact_( const H<T>&                    ob,
+                                         S&                             stats,
+                                         OctreeObj<H, T, P, M> * const  pInit
+                                       ) const noexcept;
+    // the search of find() from a node 'pInit' already checked and within
+    // the tolerance along x1: along the North-South chain within the tolerance
+    // and down the lower levels ( nullptr if not found ):
+    template<class  S>
+    OctreeObj<H, T, P, M> *  findInX1Window_( const H<T>&                    ob,
+                                              S&                             stats,
+                                              const T&                       tolerance,
+                                              OctreeObj<H, T, P, M> * const  pInit
+                                            ) const noexcept;
+    template<class  S>
+    OctreeObj<H, T, P, M> *  findIn_NWSE_SWNE_( const H<T>&                    ob,
+                                                S&                             stats,
+                                                const T&                       tolerance,
+                                                OctreeObj<H, T, P, M> * const  pInit
+                                              ) const noexcept;
+    template<class  S>
+    OctreeObj<H, T, P, M> *  findIn_WestEast_NWSE_SWNE_( const H<T>&                    ob,
+                                                         S&                             stats,
+                                                         const T&                       tolerance,
+                                                         OctreeObj<H, T, P, M> * const  pInit
+                                                       ) const noexcept;
   private:
-    OctreeObj<H, T>  *root_;
-    unsigned long    numElements_;
+    OctreeObj<H, T, P, M>  *root_;
+    unsigned long          numElements_;
+    unsigned long          numNodes_;
+    ArenaRef_              *arenas_;
+    // nullptr unless setHashIndex( true ):
+    OctreeHashIndex<H, T, P, M>  *pIndex_;
+    // the cache of countWithin(), valid until the tree changes
+    // ( refilled by one reader at a time, the one that sets 'isSlicesBusy_' ):
+    mutable std::vector<Slice_>  slices_;
+    mutable std::atomic<bool>    isSlicesValid_;
+    mutable std::atomic<bool>    isSlicesBusy_;
 };
 
 
-template<template<class> class  H, class T>
-Octree<H, T>::Octree() : root_( nullptr ), numElements_( 0 ) { }
+template<template<class> class  H, class T, class  P, bool  M>
+Octree<H, T, P, M>::Octree() : root_( nullptr ),
+                               numElements_( 0 ),
+                               numNodes_( 0 ),
+                               arenas_( nullptr ),
+                               pIndex_( nullptr ),
+                               slices_(),
+                               isSlicesValid_( false ),
+                               isSlicesBusy_( false )
+{ }
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+Octree<H, T, P, M>::Octree( Octree&&  that ) noexcept : root_( that.root_ ),
+                                                        numElements_( that.numElements_ ),
+                                                        numNodes_( that.numNodes_ ),
+                                                        arenas_( that.arenas_ ),
+                                                        pIndex_( that.pIndex_ ),
+                                                        slices_( std::move( that.slices_ ) ),
+                                                        isSlicesValid_( that.isSlicesValid_.load() ),
+                                                        isSlicesBusy_( false )
+{
+  that.root_  =  nullptr;
+  that.numElements_  =  0;
+  that.numNodes_  =  0;
+  that.arenas_  =  nullptr;
+  that.pIndex_  =  nullptr;
+  that.slices_.clear();
+  that.isSlicesValid_  =  false;
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+Octree<H, T, P, M>&
+Octree<H, T, P, M>::operator=( Octree<H, T, P, M>&&  that ) noexcept
+{
+  if ( &that == this )
+    return  *this;
+  // the former content of '*this' is destroyed together with 'tmp':
+  Octree<H, T, P, M>  tmp( std::move( that ) );
+  swap( tmp );
+  return  *this;
+}
 
 
-template<template<class> class  H, class T>
+template<template<class> class  H, class T, class  P, bool  M>
 void
-Octree<H, T>::init( H<T> * const        arr,
-                    const long&         num,
-                    bool  (*comparePoints)( const H<T>&, const H<T>& ) 
-                  ) noexcept
+Octree<H, T, P, M>::swap( Octree<H, T, P, M>&  that ) noexcept
 {
-  if ( nullptr == arr
-    || 0 >= num
+  std::swap( root_, that.root_ );
+  std::swap( numElements_, that.numElements_ );
+  std::swap( numNodes_, that.numNodes_ );
+  std::swap( arenas_, that.arenas_ );
+  std::swap( pIndex_, that.pIndex_ );
+  slices_.swap( that.slices_ );
+  isSlicesValid_  =  that.isSlicesValid_.exchange( isSlicesValid_ );
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+Octree<H, T, P, M>
+Octree<H, T, P, M>::clone() const
+{
+  Octree<H, T, P, M>  out;
+  if ( nullptr == root_ )
+    return  out;
+
+  OctreeArena<H, T, P, M> * const  pArena  =  new OctreeArena<H, T, P, M>;
+  pArena->nodes  =  new OctreeObj<H, T, P, M> [ numNodes_ ];
+  pArena->numNodes  =  numNodes_;
+  pArena->numRefs  =  1;
+  out.arenas_  =  new ArenaRef_;
+  out.arenas_->pArena  =  pArena;
+  out.arenas_->next  =  nullptr;
+
+  // walk the tree and its copy in lockstep, each node is copied
+  // as soon as the walk reaches it, so the links of the copy
+  // are relocated into the arena in a single pass:
+  OctreePath<const OctreeObj<H, T, P, M> >  path;
+  const OctreeObj<H, T, P, M>  *pOld  =  root_;
+  OctreeObj<H, T, P, M>        *pNew  =  pArena->nodes;
+  std::size_t                  numCopied  =  1;
+  copyElement_( *pNew, *pOld );
+  unsigned short  iNext  =  0;
+  while ( true )
+  {
+    if ( 8 > iNext )
+    {
+      const unsigned short  iLink  =  iNext;
+      ++iNext;
+      if ( nullptr == pOld->link( iLink )
+        || path.parentLink() == iLink
+        || numNodes_ == numCopied
+         )
+        continue;
+      path.descend( pOld, iLink );
+      OctreeObj<H, T, P, M> * const  pNewNext  =  pArena->nodes + numCopied;
+      ++numCopied;
+      copyElement_( *pNewNext, *pOld );
+      pNew->link( iLink )  =  pNewNext;
+      pNewNext->link( 7 - iLink )  =  pNew;
+      pNew  =  pNewNext;
+      iNext  =  0;
+      continue;
+    }
+    if ( true == path.isAtRoot() )
+      break;
+    const unsigned short  iLink  =  path.ascend( pOld );
+    pNew  =  pNew->link( 7 - iLink );
+    iNext  =  iLink + 1;
+  }
+
+  // the walk started at the root:
+  out.root_  =  pArena->nodes;
+  out.numElements_  =  numElements_;
+  out.numNodes_  =  numCopied;
+  return  out;
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+void
+Octree<H, T, P, M>::relayout( const OctreeLayout  layout )
+{
+  if ( nullptr == root_ )
+    return;
+
+  isSlicesValid_  =  false;
+  // the copy made by clone() is laid out depth-first in an arena of its own:
+  Octree<H, T, P, M>  out  =  clone();
+  OctreeObj<H, T, P, M> * const  pOld  =  out.arenas_->pArena->nodes;
+  const std::size_t  num  =  out.numNodes_;
+  std::vector<std::size_t>  vecOrder;
+  if ( OctreeLayout::chains == layout )
+  {
+    // the chains in the breadth-first order, starting at the North-South one:
+    // the nodes of a chain of the pair 'iPair' are placed from its 'smaller' end
+    // ( the link 'iPair' ) to its 'larger' one, and the chains of the lower
+    // pairs through every one of them are queued:
+    vecOrder.reserve( num );
+    std::vector<std::pair<std::size_t, unsigned short> >  vecChains( 1, std::make_pair( out.root_ - pOld, 0 ) );
+    for ( std::size_t  iChain = 0; iChain < vecChains.size(); ++iChain )
+    {
+      const unsigned short  iPair  =  vecChains[ iChain ].second;
+      const OctreeObj<H, T, P, M>  *p  =  pOld + vecChains[ iChain ].first;
+      while ( nullptr != p->link( iPair ) )
+        p  =  p->link( iPair );
+      for ( ; nullptr != p; p  =  p->link( 7 - iPair ) )
+      {
+        // the node the chain was reached from is placed already:
+        if ( 0 != iChain
+          && pOld + vecChains[ iChain ].first == p
+           )
+          continue;
+        vecOrder.push_back( p - pOld );
+        for ( unsigned short  iLower = iPair + 1; iLower < 4; ++iLower )
+          if ( nullptr != p->link( iLower )
+            || nullptr != p->link( 7 - iLower )
+             )
+            vecChains.push_back( std::make_pair( p - pOld, iLower ) );
+      }
+    }
+  }
+  // ( the depth-first order of the copy is kept as it is ):
+  if ( num == vecOrder.size() )
+  {
+    std::vector<std::size_t>  vecIndex( num );
+    for ( std::size_t  j = 0; j < num; ++j )
+      vecIndex[ vecOrder[ j ] ]  =  j;
+
+    // the links are relocated by the positions of the nodes they lead to:
+    OctreeObj<H, T, P, M> * const  pNew  =  new OctreeObj<H, T, P, M> [ num ];
+    for ( std::size_t  j = 0; j < num; ++j )
+    {
+      const OctreeObj<H, T, P, M>&  from  =  pOld[ vecOrder[ j ] ];
+      copyElement_( pNew[ j ], from );
+      for ( unsigned short  iLink = 0; iLink < 8; ++iLink )
+        if ( nullptr != from.link( iLink ) )
+          pNew[ j ].link( iLink )  =  pNew + vecIndex[ from.link( iLink ) - pOld ];
+    }
+    out.root_  =  pNew + vecIndex[ out.root_ - pOld ];
+    delete [] pOld;
+    out.arenas_->pArena->nodes  =  pNew;
+  }
+  swap( out );
+  std::swap( pIndex_, out.pIndex_ );
+  rebuildHashIndex_();
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+void
+Octree<H, T, P, M>::merge( Octree<H, T, P, M>&&  that ) noexcept
+{
+  if ( &that == this
+    || nullptr == that.root_
      )
     return;
+  isSlicesValid_  =  false;
+  that.isSlicesValid_  =  false;
+  if ( nullptr == root_ )
+  {
+    // the trees keep their indexes:
+    swap( that );
+    std::swap( pIndex_, that.pIndex_ );
+    if ( nullptr != that.pIndex_ )
+      that.pIndex_->clear();
+    rebuildHashIndex_();
+    return;
+  }
 
-  if ( nullptr != comparePoints )
-    std::sort( arr, arr + num, comparePoints );
-  for ( long i = 0; i < num; ++i )
+  numElements_  +=  that.numElements_;
+  numNodes_  +=  that.numNodes_;
+  // the arenas of 'that' are required by its nodes; they are taken over
+  // before the chains are merged, since the merge may release duplicates:
+  if ( nullptr != that.arenas_ )
   {
-    insert( arr[ i ] ); 
+    ArenaRef_  *pRef  =  that.arenas_;
+    while ( nullptr != pRef->next )
+      pRef  =  pRef->next;
+    pRef->next  =  arenas_;
+    arenas_  =  that.arenas_;
   }
-  // balance the tree along the North-South direction:
+  mergeChains_( 0, root_, that.root_ );
+
+  that.root_  =  nullptr;
+  that.numElements_  =  0;
+  that.numNodes_  =  0;
+  that.arenas_  =  nullptr;
+  if ( nullptr != that.pIndex_ )
+    that.pIndex_->clear();
+
+  balance_();
+  rebuildHashIndex_();
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+Octree<H, T, P, M>
+Octree<H, T, P, M>::split( const T&  pivot )
+{
+  std::size_t  numVisited  =  0;
+  return  split_( pivot, numVisited );
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+Octree<H, T, P, M>
+Octree<H, T, P, M>::split_( const T&  pivot, std::size_t&  numVisited )
+{
+  Octree<H, T, P, M>  out;
+  if ( nullptr == root_ )
+    return  out;
+
+  isSlicesValid_  =  false;
+  // the first node of the North-South chain with 'x1 >= pivot'
+  // is looked for starting at the root:
+  OctreeObj<H, T, P, M>  *pFirst  =  root_;
+  ++numVisited;
+  if ( pFirst->info.x1() < pivot )
   {
-    std::size_t  numElementsInLine  =  0;
-    OctreeObj<H, T>  *pTmp  =  root_;
-    while ( nullptr != pTmp->south )
-      pTmp  =  pTmp->south;
-    while ( nullptr != pTmp->north )
+    while ( nullptr != pFirst
+         && pFirst->info.x1() < pivot
+          )
     {
-      pTmp  =  pTmp->north;
-      ++numElementsInLine;
+      pFirst  =  pFirst->north;
+      ++numVisited;
     }
-    for ( std::size_t i = 0; i < static_cast<std::size_t>( numElementsInLine / 2 ); ++i )
+  }
+  else
+  {
+    while ( nullptr != pFirst->south
+         && false == ( pFirst->south->info.x1() < pivot )
+          )
+    {
+      pFirst  =  pFirst->south;
+      ++numVisited;
+    }
+  }
+  if ( nullptr != pIndex_ )
+    out.setHashIndex( true );
+  if ( nullptr == pFirst )
+    return  out; // all the elements stay in '*this'
+  if ( nullptr == pFirst->south )
+  {
+    swap( out ); // all the elements move to 'out'
+    std::swap( pIndex_, out.pIndex_ );
+    rebuildHashIndex_();
+    out.rebuildHashIndex_();
+    if ( nullptr != out.pIndex_ )
+      numVisited  +=  out.numNodes_;
+    return  out;
+  }
+
+  OctreeObj<H, T, P, M> * const  pLast  =  pFirst->south;
+  pLast->north  =  nullptr;
+  pFirst->south  =  nullptr;
+  root_  =  pLast;
+  out.root_  =  pFirst;
+
+  for ( const ArenaRef_ *  pRef = arenas_; nullptr != pRef; pRef = pRef->next )
+  {
+    ArenaRef_ * const  pOutRef  =  new ArenaRef_;
+    pOutRef->pArena  =  pRef->pArena;
+    pOutRef->next  =  out.arenas_;
+    out.arenas_  =  pOutRef;
+    ++pRef->pArena->numRefs;
+  }
+
+  // both halves are walked in lockstep until the smaller one is over,
+  // the size of the other one is the rest:
+  const_iterator  itLower( root_ );
+  const_iterator  itUpper( out.root_ );
+  const const_iterator  itEnd;
+  unsigned long  numLowerNodes  =  0;
+  unsigned long  numLowerElements  =  0;
+  unsigned long  numUpperNodes  =  0;
+  unsigned long  numUpperElements  =  0;
+  while ( itEnd != itLower
+       && itEnd != itUpper
+        )
+  {
+    ++numLowerNodes;
+    numLowerElements  +=  itLower->count;
+    ++itLower;
+    ++numUpperNodes;
+    numUpperElements  +=  itUpper->count;
+    ++itUpper;
+  }
+  if ( itEnd == itLower )
+  {
+    out.numNodes_  =  numNodes_ - numLowerNodes;
+    out.numElements_  =  numElements_ - numLowerElements;
+    numNodes_  =  numLowerNodes;
+    numElements_  =  numLowerElements;
+  }
+  else
+  {
+    out.numNodes_  =  numUpperNodes;
+    out.numElements_  =  numUpperElements;
+    numNodes_  -=  numUpperNodes;
+    numElements_  -=  numUpperElements;
+  }
+  numVisited  +=  numLowerNodes + numUpperNodes;
+
+  // the rebalance walks both North-South chains, the index is rebuilt from scratch:
+  numVisited  +=  balance_();
+  numVisited  +=  out.balance_();
+  rebuildHashIndex_();
+  out.rebuildHashIndex_();
+  if ( nullptr != pIndex_ )
+    numVisited  +=  numNodes_ + out.numNodes_;
+  return  out;
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+void
+Octree<H, T, P, M>::mergeChains_( const unsigned short     level,
+                                  OctreeObj<H, T, P, M> *  pA,
+                                  OctreeObj<H, T, P, M> *  pB
+                                ) noexcept
+{
+  // the chain of the level 'level' is sorted by the coordinate 'level + 1',
+  // the links 'level' ( south, east, se, ne ) lead to smaller values
+  // and the links '7 - level' ( north, west, nw, sw ) to larger ones:
+  const unsigned short  iDown  =  level;
+  const unsigned short  iUp  =  7 - level;
+
+  while ( nullptr != pA->link( iDown ) )
+    pA  =  pA->link( iDown );
+  while ( nullptr != pB->link( iDown ) )
+    pB  =  pB->link( iDown );
+
+  OctreeObj<H, T, P, M>  *pLast  =  nullptr;
+  while ( nullptr != pA
+       || nullptr != pB
+        )
+  {
+    bool  takeA  =  ( nullptr == pB );
+    if ( nullptr != pA
+      && nullptr != pB
+       )
     {
-      root_  =  root_->north;
+      const T  a  =  coordinate_( pA->info, level );
+      const T  b  =  coordinate_( pB->info, level );
+      takeA  =  ( a <= b );
+      if ( a == b
+        && 3 > level
+         )
+      {
+        // the elements of both chains that share the coordinate are merged
+        // on the next level, the node of 'that' leaves the current chain:
+        OctreeObj<H, T, P, M> * const  pNextB  =  pB->link( iUp );
+        pB->link( iDown )  =  nullptr;
+        pB->link( iUp )  =  nullptr;
+        mergeChains_( level + 1, pA, pB );
+        pB  =  pNextB;
+        continue;
+      }
+      if ( a == b
+        && true == M
+        && pA->info == pB->info
+        && nullptr == pB->north
+        && nullptr == pB->south
+        && nullptr == pB->west
+        && nullptr == pB->east
+        && nullptr == pB->nw
+        && nullptr == pB->se
+         )
+      {
+        // a duplicate with no other nodes attached to it
+        // ( the payload of the node of '*this' is kept ):
+        OctreeObj<H, T, P, M> * const  pNextB  =  pB->link( iUp );
+        addCount_( *pA, pB->count, std::integral_constant<bool, M>() );
+        releaseNode_( pB );
+        --numNodes_;
+        pB  =  pNextB;
+        continue;
+      }
     }
+    OctreeObj<H, T, P, M> * const  pTaken  =  ( true == takeA ) ? pA : pB;
+    if ( true == takeA )
+      pA  =  pA->link( iUp );
+    else
+      pB  =  pB->link( iUp );
+    pTaken->link( iDown )  =  pLast;
+    if ( nullptr != pLast )
+      pLast->link( iUp )  =  pTaken;
+    pLast  =  pTaken;
+  }
+  pLast->link( iUp )  =  nullptr;
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+T
+Octree<H, T, P, M>::coordinate_( const H<T>&  ob, const unsigned short  i ) noexcept
+{
+  if ( 0 == i )  return  ob.x1();
+  if ( 1 == i )  return  ob.x2();
+  if ( 2 == i )  return  ob.x3();
+  return  ob.x4();
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+bool
+Octree<H, T, P, M>::isWithin_( const T&  a, const T&  b, const T&  tolerance ) noexcept
+{
+  return  ToleranceCheck<T>::isWithin( a, b, tolerance );
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+bool
+Octree<H, T, P, M>::isPastX1_( const H<T>&  ob, const OctreeObj<H, T, P, M> * const  p, const unsigned short  iLink ) noexcept
+{
+  if ( 0 == iLink )
+    return  PointOrder<H, T>::template isLess<1>( p->info, ob );
+  return  PointOrder<H, T>::template isLess<1>( ob, p->info );
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+void
+Octree<H, T, P, M>::prefetch_( const OctreeObj<H, T, P, M> *  p, const unsigned short  iLink ) noexcept
+{
+#if 0 < OCTREE_DIDACTIC_PREFETCH
+  for ( unsigned short  i = 0; i < OCTREE_DIDACTIC_PREFETCH; ++i )
+  {
+    p  =  p->link( iLink );
+    if ( nullptr == p )
+      return;
+    prefetchNode_( p );
+  }
+#else
+  static_cast<void>( p );
+  static_cast<void>( iLink );
+#endif
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+void
+Octree<H, T, P, M>::prefetchNode_( const OctreeObj<H, T, P, M> * const  p ) noexcept
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+  if ( nullptr == p )
+    return;
+  __builtin_prefetch( p );
+  __builtin_prefetch( reinterpret_cast<const char *>( p + 1 ) - 1 );
+#else
+  static_cast<void>( p );
+#endif
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+std::size_t
+Octree<H, T, P, M>::balance_() noexcept
+{
+  // balance the tree along the North-South direction:
+  if ( nullptr == root_ )
+    return  0;
+  std::size_t  numHops  =  0;
+  while ( nullptr != root_->south )
+  {
+    root_  =  root_->south;
+    ++numHops;
+  }
+  std::size_t  numElementsInLine  =  0;
+  OctreeObj<H, T, P, M>  *pTmp  =  root_;
+  while ( nullptr != pTmp->north )
+  {
+    pTmp  =  pTmp->north;
+    ++numElementsInLine;
+  }
+  for ( std::size_t i = 0; i < static_cast<std::size_t>( numElementsInLine / 2 ); ++i )
+  {
+    root_  =  root_->north;
   }
+  return  numHops + numElementsInLine + numElementsInLine / 2;
 }
 
 
-template<template<class> class  H, class T>
+template<template<class> class  H, class T, class  P, bool  M>
 void
-Octree<H, T>::insert( const H<T>&  obj ) noexcept
+Octree<H, T, P, M>::init( H<T> * const        arr,
+                          const long&         num,
+                          bool  (*comparePoints)( const H<T>&, const H<T>& ) 
+                        ) noexcept
+{
+  if ( nullptr == arr
+    || 0 >= num
+     )
+    return;
+
+  if ( nullptr != comparePoints )
+    std::sort( arr, arr + num, comparePoints );
+  for ( long i = 0; i < num; ++i )
+  {
+    insert( arr[ i ] ); 
+  }
+  balance_();
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+OctreeObj<H, T, P, M> *
+Octree<H, T, P, M>::insert_( const H<T>&  obj ) noexcept
 {
   if ( nullptr == root_ )
   {
-    root_  =  new OctreeObj<H, T >;
+    root_  =  new OctreeObj<H, T, P, M>;
     root_->info  =  obj;
     ++numElements_;
-    return;
+    ++numNodes_;
+    return  root_;
   }
 
-  OctreeObj<H, T>  *pTmp  =  root_;
+  OctreeObj<H, T, P, M>  *pTmp  =  root_;
 
-  const T&  x1  =  obj.x1();
-  const T&  x2  =  obj.x2();
-  const T&  x3  =  obj.x3();
-  const T&  x4  =  obj.x4();
+  typedef  PointOrder<H, T>  Order;
 
   while ( nullptr != pTmp->north
-       && x1 >= pTmp->info.x1()
+       && true == Order::template isNotLess<1>( obj, pTmp->info )
         )
   {
     pTmp  =  pTmp->north;
   }
 
   while ( nullptr != pTmp->south
-       && x1 < pTmp->info.x1()
+       && true == Order::template isLess<1>( obj, pTmp->info )
         )
   {
     pTmp  =  pTmp->south;
   }
 
   while ( nullptr != pTmp->west
-       && x2 >= pTmp->info.x2()
-       && x1 == pTmp->info.x1()
+       && true == Order::template isNotLess<2>( obj, pTmp->info )
         )
   {
     pTmp  =  pTmp->west;
   }
 
   while ( nullptr != pTmp->east
-       && x2 < pTmp->info.x2()
-       && x1 == pTmp->info.x1()
+       && true == Order::template isLess<2>( obj, pTmp->info )
         )
   {
     pTmp  =  pTmp->east;
   }
 
   while ( nullptr != pTmp->nw
-       && x3 >= pTmp->info.x3()
-       && x2 == pTmp->info.x2()
-       && x1 == pTmp->info.x1()
+       && true == Order::template isNotLess<3>( obj, pTmp->info )
         )
   {
     pTmp  =  pTmp->nw;
   }
 
   while ( nullptr != pTmp->se
-       && x3 < pTmp->info.x3()
-       && x2 == pTmp->info.x2()
-       && x1 == pTmp->info.x1()
+       && true == Order::template isLess<3>( obj, pTmp->info )
         )
   {
     pTmp  =  pTmp->se;
   }
 
   while ( nullptr != pTmp->sw
-       && x4 >= pTmp->info.x4()
-       && x1 == pTmp->info.x1()
-       && x2 == pTmp->info.x2()
-       && x3 == pTmp->info.x3()
+       && true == Order::template isNotLess<4>( obj, pTmp->info )
         )
   {
     pTmp  =  pTmp->sw;
   }
 
   while ( nullptr != pTmp->ne
-       && x4 < pTmp->info.x4()
-       && x1 == pTmp->info.x1()
-       && x2 == pTmp->info.x2()
-       && x3 == pTmp->info.x3()
+       && true == Order::template isLess<4>( obj, pTmp->info )
         )
   {
     pTmp  =  pTmp->ne;
   }
 
+  // the walk above ends at the twin of 'obj' if the tree contains one:
+  if ( true == M
+    && obj == pTmp->info
+     )
+  {
+    addCount_( *pTmp, 1, std::integral_constant<bool, M>() );
+    ++numElements_;
+    return  pTmp;
+  }
+
   if ( nullptr == pTmp->sw
-    && x4 >= pTmp->info.x4()
-    && x1 == pTmp->info.x1()
-    && x2 == pTmp->info.x2()
-    && x3 == pTmp->info.x3()
+    && true == Order::template isNotLess<4>( obj, pTmp->info )
      )
   {
-    pTmp->sw  =  new OctreeObj<H, T>;
+    pTmp->sw  =  new OctreeObj<H, T, P, M>;
     pTmp->sw->info  =  obj;
     pTmp->sw->ne  =  pTmp;
     ++numElements_;
-    return;
+    ++numNodes_;
+    return  pTmp->sw;
   }
 
   if ( nullptr == pTmp->ne
-    && x4 < pTmp->info.x4()
-    && x1 == pTmp->info.x1()
-    && x2 == pTmp->info.x2()
-    && x3 == pTmp->info.x3()
+    && true == Order::template isLess<4>( obj, pTmp->info )
      )
   {
-    pTmp->ne  =  new OctreeObj<H, T>;
+    pTmp->ne  =  new OctreeObj<H, T, P, M>;
     pTmp->ne->info  =  obj;
     pTmp->ne->sw  =  pTmp;
     ++numElements_;
-    return;
+    ++numNodes_;
+    return  pTmp->ne;
   }
 
   if ( nullptr == pTmp->nw
-    && x3 >= pTmp->info.x3()
-    && x1 == pTmp->info.x1()
-    && x2 == pTmp->info.x2()
+    && true == Order::template isNotLess<3>( obj, pTmp->info )
      )
   {
-    pTmp->nw  =  new OctreeObj<H, T>;
+    pTmp->nw  =  new OctreeObj<H, T, P, M>;
     pTmp->nw->info  =  obj;
     pTmp->nw->se  =  pTmp;
     ++numElements_;
-    return;
+    ++numNodes_;
+    return  pTmp->nw;
   }
 
   if ( nullptr == pTmp->se
-    && x3 < pTmp->info.x3()
-    && x1 == pTmp->info.x1()
-    && x2 == pTmp->info.x2()
+    && true == Order::template isLess<3>( obj, pTmp->info )
      )
   {
-    pTmp->se  =  new OctreeObj<H, T>;
+    pTmp->se  =  new OctreeObj<H, T, P, M>;
     pTmp->se->info  =  obj;
     pTmp->se->nw  =  pTmp;
     ++numElements_;
-    return;
+    ++numNodes_;
+    return  pTmp->se;
   }
 
   if ( nullptr == pTmp->west
-    && x2 >= pTmp->info.x2()
-    && x1 == pTmp->info.x1()
+    && true == Order::template isNotLess<2>( obj, pTmp->info )
      )
   {
-    pTmp->west  =  new OctreeObj<H, T>;
+    pTmp->west  =  new OctreeObj<H, T, P, M>;
     pTmp->west->info  =  obj;
     pTmp->west->east  =  pTmp;
     ++numElements_;
-    return;
+    ++numNodes_;
+    return  pTmp->west;
   }
 
   if ( nullptr == pTmp->east
-    && x2 < pTmp->info.x2()
-    && x1 == pTmp->info.x1()
+    && true == Order::template isLess<2>( obj, pTmp->info )
      )
   {
-    pTmp->east  =  new OctreeObj<H, T>;
+    pTmp->east  =  new OctreeObj<H, T, P, M>;
     pTmp->east->info  =  obj;
     pTmp->east->west  =  pTmp;
     ++numElements_;
-    return;
+    ++numNodes_;
+    return  pTmp->east;
   }
 
   if ( nullptr == pTmp->north
-    && x1 >= pTmp->info.x1()
+    && true == Order::template isNotLess<1>( obj, pTmp->info )
      )
   {
-    pTmp->north  =  new OctreeObj<H, T>;
+    pTmp->north  =  new OctreeObj<H, T, P, M>;
     pTmp->north->info  =  obj;
     pTmp->north->south  =  pTmp;
     ++numElements_;
-    return;
+    ++numNodes_;
+    return  pTmp->north;
   }
 
   if ( nullptr == pTmp->south
-    && x1 < pTmp->info.x1()
+    && true == Order::template isLess<1>( obj, pTmp->info )
      )
   {
-    pTmp->south  =  new OctreeObj<H, T>;
+    pTmp->south  =  new OctreeObj<H, T, P, M>;
     pTmp->south->info  =  obj;
     pTmp->south->north  =  pTmp;
     ++numElements_;
+    ++numNodes_;
+    return  pTmp->south;
+  }
+
+  return  nullptr;
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+void
+Octree<H, T, P, M>::insert( const H<T>&  obj ) noexcept
+{
+  isSlicesValid_  =  false;
+  OctreeObj<H, T, P, M> * const  p  =  insert_( obj );
+  if ( nullptr != p )
+    indexNode_( p );
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+template<class  Q>
+void
+Octree<H, T, P, M>::init( const H<T> * const  arr,
+                          const Q * const     payloads,
+                          const long&         num,
+                          bool  (*comparePoints)( const H<T>&, const H<T>& )
+                        )
+{
+  if ( nullptr == arr
+    || nullptr == payloads
+    || 0 >= num
+     )
+    return;
+
+  // a stable sort, so that the payload of the last one of equal elements
+  // is kept in the multiset mode:
+  std::vector<long>  vecOrder( static_cast<std::size_t>( num ) );
+  for ( long i = 0; i < num; ++i )
+    vecOrder[ i ]  =  i;
+  if ( nullptr != comparePoints )
+    std::stable_sort( vecOrder.begin(), vecOrder.end(), [ & ] ( const long  a, const long  b ) {
+      return  comparePoints( arr[ a ], arr[ b ] );
+    } );
+  for ( const long  i : vecOrder )
+    insert( arr[ i ], payloads[ i ] );
+  balance_();
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+template<class  Q>
+OctreeObj<H, T, P, M> *
+Octree<H, T, P, M>::insert( const H<T>&  obj, const Q&  payload )
+{
+  isSlicesValid_  =  false;
+  OctreeObj<H, T, P, M> * const  p  =  insert_( obj );
+  if ( nullptr == p )
+    return  nullptr;
+  p->payload  =  payload;
+  indexNode_( p );
+  return  p;
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+void
+Octree<H, T, P, M>::setHashIndex( const bool  isIndexed )
+{
+  if ( false == isIndexed )
+  {
+    delete  pIndex_;
+    pIndex_  =  nullptr;
+    return;
+  }
+  if ( nullptr != pIndex_ )
+    return;
+  pIndex_  =  new OctreeHashIndex<H, T, P, M>;
+  rebuildHashIndex_();
+  // unlike the index kept up to date by the calls that change the tree,
+  // an index asked for explicitly is not dropped silently:
+  if ( nullptr == pIndex_ )
+    throw  std::bad_alloc();
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+bool
+Octree<H, T, P, M>::hasHashIndex() const noexcept
+{
+  return  nullptr != pIndex_;
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+void
+Octree<H, T, P, M>::rebuildHashIndex_() noexcept
+{
+  if ( nullptr == pIndex_ )
+    return;
+  pIndex_->clear();
+  try
+  {
+    // the tree owns its nodes, the iteration merely views them as constant:
+    for ( const OctreeObj<H, T, P, M>&  obj : *this )
+      pIndex_->insert( const_cast<OctreeObj<H, T, P, M> *>( &obj ) );
+  }
+  catch ( const std::bad_alloc& )
+  {
+    dropHashIndex_();
+  }
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+void
+Octree<H, T, P, M>::indexNode_( OctreeObj<H, T, P, M> * const  p ) noexcept
+{
+  if ( nullptr == pIndex_ )
+    return;
+  try
+  {
+    pIndex_->insert( p );
+  }
+  catch ( const std::bad_alloc& )
+  {
+    dropHashIndex_();
+  }
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+void
+Octree<H, T, P, M>::dropHashIndex_() noexcept
+{
+  delete  pIndex_;
+  pIndex_  =  nullptr;
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+void
+Octree<H, T, P, M>::copyElement_( OctreeObj<H, T, P, M>&  to, const OctreeObj<H, T, P, M>&  from )
+{
+  to.info  =  from.info;
+  static_cast<OctreeCount<M>&>( to )  =  from;
+  static_cast<OctreePayload<P>&>( to )  =  from;
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+Octree<H, T, P, M>::~Octree()
+{
+  delete  pIndex_;
+  if ( nullptr == root_ )
+  {
+    releaseArenas_();
     return;
   }
 
-  pTmp  =  nullptr;
+  while ( nullptr != root_ )
+  {
+    // a single remaining node is not an end node of any chain,
+    // so it has to be handled before walking the chains:
+    if ( nullptr == root_->north
+      && nullptr == root_->south
+      && nullptr == root_->west
+      && nullptr == root_->east
+      && nullptr == root_->nw
+      && nullptr == root_->ne
+      && nullptr == root_->sw
+      && nullptr == root_->se
+       )
+    {
+      releaseNode_( root_ );
+      root_  =  nullptr;
+      break;
+    }
+
+    getRootToEndNode_();
+    deleteEndNodes_();
+  } // while ( nullptr != root_ )
+
+  releaseArenas_();
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+const unsigned long&
+Octree<H, T, P, M>::getNumElements() const noexcept
+{
+  return  numElements_;
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+const unsigned long&
+Octree<H, T, P, M>::getNumNodes() const noexcept
+{
+  return  numNodes_;
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+OctreeStats
+Octree<H, T, P, M>::stats() const noexcept
+{
+  OctreeStats  out;
+  out.numNodes  =  numNodes_;
+  out.numElements  =  numElements_;
+  out.numBytes  =  sizeof( *this );
+  for ( const ArenaRef_ *  pRef = arenas_; nullptr != pRef; pRef = pRef->next )
+    out.numBytes  +=  sizeof( ArenaRef_ )
+                    + sizeof( OctreeArena<H, T, P, M> )
+                    + pRef->pArena->numNodes * sizeof( OctreeObj<H, T, P, M> );
+  if ( nullptr != pIndex_ )
+  {
+    out.numIndexBytes  =  pIndex_->getNumBytes();
+    out.numBytes  +=  out.numIndexBytes;
+  }
+  if ( nullptr == root_ )
+    return  out;
+
+  for ( const OctreeObj<H, T, P, M> *  p = root_->south; nullptr != p; p = p->south )
+    ++out.distanceToSouth;
+  for ( const OctreeObj<H, T, P, M> *  p = root_->north; nullptr != p; p = p->north )
+    ++out.distanceToNorth;
+  const std::size_t  numInLine  =  out.distanceToSouth + out.distanceToNorth;
+  if ( 0 < numInLine )
+    out.balance  =  2. * std::min( out.distanceToSouth, out.distanceToNorth ) / numInLine;
+
+  std::size_t  depth  =  0;
+  std::size_t  sumDepth  =  0;
+  std::size_t  numVisited  =  0;
+  auto  visit  =  [ & ] ( const OctreeObj<H, T, P, M> * const  p ) {
+    ++numVisited;
+    sumDepth  +=  depth;
+    if ( out.maxDepth < depth )
+      out.maxDepth  =  depth;
+    if ( false == isInArena_( p ) )
+      out.numBytes  +=  sizeof( OctreeObj<H, T, P, M> );
+    // every chain is measured once, from its lowest node:
+    for ( unsigned short  iPair = 0; iPair < 4; ++iPair )
+    {
+      if ( nullptr != p->link( iPair )
+        || nullptr == p->link( 7 - iPair )
+         )
+        continue;
+      std::size_t  length  =  1;
+      for ( const OctreeObj<H, T, P, M> *  q = p->link( 7 - iPair ); nullptr != q; q = q->link( 7 - iPair ) )
+        ++length;
+      unsigned short  iBin  =  0;
+      while ( OctreeStats::numBins > iBin + 1
+           && ( length >> ( iBin + 1 ) ) > 0
+            )
+        ++iBin;
+      ++out.chainLengths[ iPair ][ iBin ];
+      ++out.numChains[ iPair ];
+      out.sumChainLength[ iPair ]  +=  length;
+      if ( out.maxChainLength[ iPair ] < length )
+        out.maxChainLength[ iPair ]  =  length;
+    }
+  };
+
+  // the same depth-first walk as in clone():
+  OctreePath<const OctreeObj<H, T, P, M> >  path;
+  const OctreeObj<H, T, P, M>  *p  =  root_;
+  visit( p );
+  unsigned short  iNext  =  0;
+  while ( true )
+  {
+    if ( 8 > iNext )
+    {
+      const unsigned short  iLink  =  iNext;
+      ++iNext;
+      if ( nullptr == p->link( iLink )
+        || path.parentLink() == iLink
+         )
+        continue;
+      path.descend( p, iLink );
+      ++depth;
+      visit( p );
+      iNext  =  0;
+      continue;
+    }
+    if ( true == path.isAtRoot() )
+      break;
+    const unsigned short  iLink  =  path.ascend( p );
+    --depth;
+    iNext  =  iLink + 1;
+  }
+  out.meanDepth  =  static_cast<double>( sumDepth ) / numVisited;
+  return  out;
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+bool
+Octree<H, T, P, M>::isMultiset() const noexcept
+{
+  return  M;
 }
 
 
-template<template<class> class  H, class T>
-Octree<H, T>::~Octree()
+template<template<class> class  H, class T, class  P, bool  M>
+typename Octree<H, T, P, M>::const_iterator
+Octree<H, T, P, M>::begin() const noexcept
 {
-  if ( nullptr == root_ )
-    return;
-
-  while ( nullptr != root_ )
-  {
-    getRootToEndNode_();
-    deleteEndNodes_();
-
-    if ( nullptr == root_->north
-      && nullptr == root_->south
-      && nullptr == root_->west
-      && nullptr == root_->east
-      && nullptr == root_->nw
-      && nullptr == root_->ne
-      && nullptr == root_->sw
-      && nullptr == root_->se
-       )
-    {
-      delete  root_;
-      root_  =  nullptr;
-    }
-  } // while ( nullptr != root_ )
+  return  const_iterator( root_ );
 }
 
 
-template<template<class> class  H, class T>
-const unsigned long&
-Octree<H, T>::getNumElements() const noexcept
+template<template<class> class  H, class T, class  P, bool  M>
+typename Octree<H, T, P, M>::const_iterator
+Octree<H, T, P, M>::end() const noexcept
 {
-  return  numElements_;
+  return  const_iterator();
 }
 
 
-template<template<class> class  H, class T>
+template<template<class> class  H, class T, class  P, bool  M>
+template<class  S>
 bool
-Octree<H, T>::isWithinTolerance_( const H<T>&              ob,
-                                  const T&                 tolerance,
-                                  OctreeObj<H, T> * const  pTmp
-                                ) const noexcept
+Octree<H, T, P, M>::isWithinTolerance_( const H<T>&                    ob,
+                                        const T&                       tolerance,
+                                        OctreeObj<H, T, P, M> * const  pTmp,
+                                        S&                             stats
+                                      ) const noexcept
 {
+  stats.predicate();
   if ( nullptr != pTmp
-    && tolerance >= std::abs( ob.x1() - pTmp->info.x1() )
-    && tolerance >= std::abs( ob.x2() - pTmp->info.x2() )
-    && tolerance >= std::abs( ob.x3() - pTmp->info.x3() )
-    && tolerance >= std::abs( ob.x4() - pTmp->info.x4() )
+    && true == isWithin_( ob.x1(), pTmp->info.x1(), tolerance )
+    && true == isWithin_( ob.x2(), pTmp->info.x2(), tolerance )
+    && true == isWithin_( ob.x3(), pTmp->info.x3(), tolerance )
+    && true == isWithin_( ob.x4(), pTmp->info.x4(), tolerance )
      )
     return  true;
   return  false;
 }
 
 
-template<template<class> class  H, class T>
-OctreeObj<H, T> *
-Octree<H, T>::moveAlongWestEast_( const H<T>&              ob,
-                                  const T&                 tolerance,
-                                  OctreeObj<H, T> * const  pTmpIn,
-                                  std::size_t&             numOperations
-                                ) const noexcept
+template<template<class> class  H, class T, class  P, bool  M>
+template<class  S>
+bool
+Octree<H, T, P, M>::isSameElement_( const H<T>&                          ob,
+                                    const OctreeObj<H, T, P, M> * const  pTmp,
+                                    S&                                   stats
+                                  ) const noexcept
+{
+  stats.predicate();
+  return  nullptr != pTmp
+       && true == PointOrder<H, T>::template isSamePrefix<4>( ob, pTmp->info );
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+template<class  S>
+OctreeObj<H, T, P, M> *
+Octree<H, T, P, M>::moveAlongWestEast_( const H<T>&                    ob,
+                                        const T&                       tolerance,
+                                        OctreeObj<H, T, P, M> * const  pTmpIn,
+                                        S&                             stats
+                                      ) const noexcept
 {
   if ( nullptr == pTmpIn )
     return  nullptr;
 
-  if ( true == isWithinTolerance_( ob, tolerance, pTmpIn ) )
+  if ( true == isWithinTolerance_( ob, tolerance, pTmpIn, stats ) )
     return  pTmpIn;
 
-  OctreeObj<H, T> *  pTmp  =  pTmpIn;
+  OctreeObj<H, T, P, M> *  pTmp  =  pTmpIn;
 
   while ( nullptr != pTmp->west
-       && tolerance < std::abs( ob.x2() - pTmp->info.x2() )
+       && false == isWithin_( ob.x2(), pTmp->info.x2(), tolerance )
         )
   {
     pTmp  =  pTmp->west;
-    ++numOperations;
-    if ( true == isWithinTolerance_( ob, tolerance, pTmp ) )
+    prefetch_( pTmp, 6 );
+    stats.hop( 1 );
+    if ( true == isWithinTolerance_( ob, tolerance, pTmp, stats ) )
       return  pTmp;
   }
 
-  OctreeObj<H, T> *  pTmp1  =  pTmp;
+  OctreeObj<H, T, P, M> *  pTmp1  =  pTmp;
 
   while ( nullptr != pTmp1->west
-       && tolerance >= std::abs( ob.x2() - pTmp1->west->info.x2() )
+       && true == isWithin_( ob.x2(), pTmp1->west->info.x2(), tolerance )
         )
   {
     pTmp1  =  pTmp1->west;
-    ++numOperations;
-    if ( true == isWithinTolerance_( ob, tolerance, pTmp1 ) )
+    prefetch_( pTmp1, 6 );
+    stats.hop( 1 );
+    if ( true == isWithinTolerance_( ob, tolerance, pTmp1, stats ) )
       return  pTmp1;
   }
 
-  if ( tolerance >= std::abs( ob.x2() - pTmp->info.x2() ) )
+  if ( true == isWithin_( ob.x2(), pTmp->info.x2(), tolerance ) )
     return  pTmp;
 
   pTmp  =  pTmpIn;
 
   while ( nullptr != pTmp->east
-       && tolerance < std::abs( ob.x2() - pTmp->info.x2() )
+       && false == isWithin_( ob.x2(), pTmp->info.x2(), tolerance )
         )
   {
     pTmp  =  pTmp->east;
-    ++numOperations;
-    if ( true == isWithinTolerance_( ob, tolerance, pTmp ) )
+    prefetch_( pTmp, 1 );
+    stats.hop( 1 );
+    if ( true == isWithinTolerance_( ob, tolerance, pTmp, stats ) )
       return  pTmp;
   }
 
-  OctreeObj<H, T> *  pTmp2  =  pTmp;
+  OctreeObj<H, T, P, M> *  pTmp2  =  pTmp;
 
   while ( nullptr != pTmp2->east
-       && tolerance >= std::abs( ob.x2() - pTmp2->east->info.x2() )
+       && true == isWithin_( ob.x2(), pTmp2->east->info.x2(), tolerance )
         )
   {
     pTmp2  =  pTmp2->east;
-    ++numOperations;
-    if ( true == isWithinTolerance_( ob, tolerance, pTmp2 ) )
+    prefetch_( pTmp2, 1 );
+    stats.hop( 1 );
+    if ( true == isWithinTolerance_( ob, tolerance, pTmp2, stats ) )
       return  pTmp2;
   }
 
-  if ( tolerance >= std::abs( ob.x2() - pTmp->info.x2() ) )
+  if ( true == isWithin_( ob.x2(), pTmp->info.x2(), tolerance ) )
     return  pTmp;
 
   return  pTmpIn; // not found
 }
 
 
-template<template<class> class  H, class T>
-OctreeObj<H, T> *
-Octree<H, T>::moveAlongNWSE_( const H<T>&              ob,
-                              const T&                 tolerance,
-                              OctreeObj<H, T> * const  pTmpIn,
-                              std::size_t&             numOperations
-                            ) const noexcept
+template<template<class> class  H, class T, class  P, bool  M>
+template<class  S>
+OctreeObj<H, T, P, M> *
+Octree<H, T, P, M>::moveAlongNWSE_( const H<T>&                    ob,
+                                    const T&                       tolerance,
+                                    OctreeObj<H, T, P, M> * const  pTmpIn,
+                                    S&                             stats
+                                  ) const noexcept
 {
   if ( nullptr == pTmpIn )
     return  nullptr;
 
-  if ( true == isWithinTolerance_( ob, tolerance, pTmpIn ) )
+  if ( true == isWithinTolerance_( ob, tolerance, pTmpIn, stats ) )
     return  pTmpIn;
 
-  OctreeObj<H, T> *  pTmp  =  pTmpIn;
+  OctreeObj<H, T, P, M> *  pTmp  =  pTmpIn;
 
   while ( nullptr != pTmp->nw
-       && tolerance < std::abs( ob.x3() - pTmp->info.x3() )
+       && false == isWithin_( ob.x3(), pTmp->info.x3(), tolerance )
         )
   {
     pTmp  =  pTmp->nw;
-    ++numOperations;
-    if ( true == isWithinTolerance_( ob, tolerance, pTmp ) )
+    prefetch_( pTmp, 5 );
+    stats.hop( 2 );
+    if ( true == isWithinTolerance_( ob, tolerance, pTmp, stats ) )
       return  pTmp;
   }
 
-  OctreeObj<H, T> *  pTmp1  =  pTmp;
+  OctreeObj<H, T, P, M> *  pTmp1  =  pTmp;
 
   while ( nullptr != pTmp1->nw
-       && tolerance >= std::abs( ob.x3() - pTmp1->nw->info.x3() )
+       && true == isWithin_( ob.x3(), pTmp1->nw->info.x3(), tolerance )
         )
   {
     pTmp1  =  pTmp1->nw;
-    ++numOperations;
-    if ( true == isWithinTolerance_( ob, tolerance, pTmp1 ) )
+    prefetch_( pTmp1, 5 );
+    stats.hop( 2 );
+    if ( true == isWithinTolerance_( ob, tolerance, pTmp1, stats ) )
       return  pTmp1;
   }
 
-  if ( tolerance >= std::abs( ob.x3() - pTmp->info.x3() ) )
+  if ( true == isWithin_( ob.x3(), pTmp->info.x3(), tolerance ) )
     return  pTmp;
 
   pTmp  =  pTmpIn;
 
   while ( nullptr != pTmp->se
-       && tolerance < std::abs( ob.x3() - pTmp->info.x3() )
+       && false == isWithin_( ob.x3(), pTmp->info.x3(), tolerance )
         )
   {
     pTmp  =  pTmp->se;
-    ++numOperations;
-    if ( true == isWithinTolerance_( ob, tolerance, pTmp ) )
+    prefetch_( pTmp, 2 );
+    stats.hop( 2 );
+    if ( true == isWithinTolerance_( ob, tolerance, pTmp, stats ) )
       return  pTmp;
   }
 
-  OctreeObj<H, T> *  pTmp2  =  pTmp;
+  OctreeObj<H, T, P, M> *  pTmp2  =  pTmp;
 
   while ( nullptr != pTmp2->se
-       && tolerance >= std::abs( ob.x3() - pTmp2->se->info.x3() )
+       && true == isWithin_( ob.x3(), pTmp2->se->info.x3(), tolerance )
         )
   {
     pTmp2  =  pTmp2->se;
-    ++numOperations;
-    if ( true == isWithinTolerance_( ob, tolerance, pTmp2 ) )
+    prefetch_( pTmp2, 2 );
+    stats.hop( 2 );
+    if ( true == isWithinTolerance_( ob, tolerance, pTmp2, stats ) )
       return  pTmp2;
   }
 
-  if ( tolerance >= std::abs( ob.x3() - pTmp->info.x3() ) )
+  if ( true == isWithin_( ob.x3(), pTmp->info.x3(), tolerance ) )
     return  pTmp;
   
   return  pTmpIn; // not found
 }
 
 
-template<template<class> class  H, class T>
-OctreeObj<H, T> *
-Octree<H, T>::moveAlongSWNE_( const H<T>&              ob,
-                              const T&                 tolerance,
-                              OctreeObj<H, T> * const  pTmpIn,
-                              std::size_t&             numOperations
-                            ) const noexcept
+template<template<class> class  H, class T, class  P, bool  M>
+template<class  S>
+OctreeObj<H, T, P, M> *
+Octree<H, T, P, M>::moveAlongSWNE_( const H<T>&                    ob,
+                                    const T&                       tolerance,
+                                    OctreeObj<H, T, P, M> * const  pTmpIn,
+                                    S&                             stats
+                                  ) const noexcept
 {
   if ( nullptr == pTmpIn )
     return  nullptr;
 
-  if ( true == isWithinTolerance_( ob, tolerance, pTmpIn ) )
+  if ( true == isWithinTolerance_( ob, tolerance, pTmpIn, stats ) )
     return  pTmpIn;
 
-  OctreeObj<H, T> *  pTmp  =  pTmpIn;
+  OctreeObj<H, T, P, M> *  pTmp  =  pTmpIn;
 
   while ( nullptr != pTmp->sw
-       && tolerance < std::abs( ob.x4() - pTmp->info.x4() )
+       && false == isWithin_( ob.x4(), pTmp->info.x4(), tolerance )
         )
   {
     pTmp  =  pTmp->sw;
-    ++numOperations;
-    if ( true == isWithinTolerance_( ob, tolerance, pTmp ) )
+    prefetch_( pTmp, 4 );
+    stats.hop( 3 );
+    if ( true == isWithinTolerance_( ob, tolerance, pTmp, stats ) )
       return  pTmp;
   }
 
   while ( nullptr != pTmp->sw
-       && tolerance >= std::abs( ob.x4() - pTmp->sw->info.x4() )
+       && true == isWithin_( ob.x4(), pTmp->sw->info.x4(), tolerance )
         )
   {
     pTmp  =  pTmp->sw;
-    ++numOperations;
-    if ( true == isWithinTolerance_( ob, tolerance, pTmp ) )
+    prefetch_( pTmp, 4 );
+    stats.hop( 3 );
+    if ( true == isWithinTolerance_( ob, tolerance, pTmp, stats ) )
       return  pTmp;
   }
 
   pTmp  =  pTmpIn;
 
   while ( nullptr != pTmp->ne
-       && tolerance < std::abs( ob.x4() - pTmp->info.x4() )
+       && false == isWithin_( ob.x4(), pTmp->info.x4(), tolerance )
         )
   {
     pTmp  =  pTmp->ne;
-    ++numOperations;
-    if ( true == isWithinTolerance_( ob, tolerance, pTmp ) )
+    prefetch_( pTmp, 3 );
+    stats.hop( 3 );
+    if ( true == isWithinTolerance_( ob, tolerance, pTmp, stats ) )
       return  pTmp;
   }
 
   while ( nullptr != pTmp->ne
-       && tolerance >= std::abs( ob.x4() - pTmp->ne->info.x4() )
+       && true == isWithin_( ob.x4(), pTmp->ne->info.x4(), tolerance )
         )
   {
     pTmp  =  pTmp->ne;
-    ++numOperations;
-    if ( true == isWithinTolerance_( ob, tolerance, pTmp ) )
+    prefetch_( pTmp, 3 );
+    stats.hop( 3 );
+    if ( true == isWithinTolerance_( ob, tolerance, pTmp, stats ) )
       return  pTmp;
   }
 
@@ -588,43 +2252,46 @@ Octree<H, T>::moveAlongSWNE_( const H<T>&              ob,
 }
 
 
-template<template<class> class  H, class T>
-OctreeObj<H, T> *
-Octree<H, T>::findIn_NWSE_SWNE_( const H<T>&              ob,
-                                 std::size_t&             numOperations,
-                                 const T&                 tolerance,
-                                 OctreeObj<H, T> * const  pInit
-                               ) const noexcept
+template<template<class> class  H, class T, class  P, bool  M>
+template<class  S>
+OctreeObj<H, T, P, M> *
+Octree<H, T, P, M>::findIn_NWSE_SWNE_( const H<T>&                    ob,
+                                       S&                             stats,
+                                       const T&                       tolerance,
+                                       OctreeObj<H, T, P, M> * const  pInit
+                                     ) const noexcept
 {
   if ( nullptr == pInit )
     return  nullptr;
-  if ( tolerance < std::abs( ob.x3() - pInit->info.x3() ) )
+  if ( false == isWithin_( ob.x3(), pInit->info.x3(), tolerance ) )
     return  pInit;
 
-  OctreeObj<H, T> *  pTmp  =  pInit;
+  OctreeObj<H, T, P, M> *  pTmp  =  pInit;
 
   while ( nullptr != pTmp->se
-       && tolerance >= std::abs( ob.x3() - pTmp->se->info.x3() )
+       && true == isWithin_( ob.x3(), pTmp->se->info.x3(), tolerance )
         )
   {
     pTmp  =  pTmp->se;
-    ++numOperations;
+    prefetch_( pTmp, 2 );
+    stats.hop( 2 );
   }
   do {
-    if ( true == isWithinTolerance_( ob, tolerance, pTmp ) )
+    if ( true == isWithinTolerance_( ob, tolerance, pTmp, stats ) )
       return  pTmp;
     else
       {
-        OctreeObj<H, T> * const  pTmp4  =  moveAlongSWNE_( ob, tolerance, pTmp, numOperations );
-        if ( true == isWithinTolerance_( ob, tolerance, pTmp4 ) )
+        OctreeObj<H, T, P, M> * const  pTmp4  =  moveAlongSWNE_( ob, tolerance, pTmp, stats );
+        if ( true == isWithinTolerance_( ob, tolerance, pTmp4, stats ) )
           return  pTmp4;
       }
     if ( nullptr != pTmp->nw
-      && tolerance >= std::abs( ob.x3() - pTmp->nw->info.x3() )
+      && true == isWithin_( ob.x3(), pTmp->nw->info.x3(), tolerance )
        )
     {
       pTmp  =  pTmp->nw;
-      ++numOperations;
+      prefetch_( pTmp, 5 );
+      stats.hop( 2 );
     }
     else
       break;
@@ -635,56 +2302,59 @@ Octree<H, T>::findIn_NWSE_SWNE_( const H<T>&              ob,
 }
 
 
-template<template<class> class  H, class T>
-OctreeObj<H, T> *
-Octree<H,T>::findIn_WestEast_NWSE_SWNE_( const H<T>&              ob,
-                                         std::size_t&             numOperations,
-                                         const T&                 tolerance,
-                                         OctreeObj<H, T> * const  pInit
-                                       ) const noexcept
+template<template<class> class  H, class T, class  P, bool  M>
+template<class  S>
+OctreeObj<H, T, P, M> *
+Octree<H, T, P, M>::findIn_WestEast_NWSE_SWNE_( const H<T>&                    ob,
+                                                S&                             stats,
+                                                const T&                       tolerance,
+                                                OctreeObj<H, T, P, M> * const  pInit
+                                              ) const noexcept
 {
   if ( nullptr == pInit )
     return  nullptr;
-  if ( tolerance < std::abs( ob.x2() - pInit->info.x2() ) )
+  if ( false == isWithin_( ob.x2(), pInit->info.x2(), tolerance ) )
     return  pInit;
 
-  OctreeObj<H, T> *  pTmp  =  pInit;
+  OctreeObj<H, T, P, M> *  pTmp  =  pInit;
 
   while ( nullptr != pTmp->east
-       && tolerance >= std::abs( ob.x2() - pTmp->east->info.x2() )
+       && true == isWithin_( ob.x2(), pTmp->east->info.x2(), tolerance )
         )
   {
     pTmp  =  pTmp->east;
-    ++numOperations;
+    prefetch_( pTmp, 1 );
+    stats.hop( 1 );
   }
   do {
     if ( nullptr != pTmp
-      && tolerance >= std::abs( ob.x3() - pTmp->info.x3() )
+      && true == isWithin_( ob.x3(), pTmp->info.x3(), tolerance )
        )
     {
-      OctreeObj<H, T> * const  pTmp3  =  findIn_NWSE_SWNE_( ob, numOperations, tolerance, pTmp );
-      if ( true == isWithinTolerance_( ob, tolerance, pTmp3 ) )
+      OctreeObj<H, T, P, M> * const  pTmp3  =  findIn_NWSE_SWNE_( ob, stats, tolerance, pTmp );
+      if ( true == isWithinTolerance_( ob, tolerance, pTmp3, stats ) )
         return  pTmp3;
     }
     else
       {
-        OctreeObj<H, T> * const  pTmp2  =  moveAlongNWSE_( ob, tolerance, pTmp, numOperations );
+        OctreeObj<H, T, P, M> * const  pTmp2  =  moveAlongNWSE_( ob, tolerance, pTmp, stats );
         if ( nullptr != pTmp2
-          && tolerance >= std::abs( ob.x2() - pTmp2->info.x2() )
-          && tolerance >= std::abs( ob.x3() - pTmp2->info.x3() )
+          && true == isWithin_( ob.x2(), pTmp2->info.x2(), tolerance )
+          && true == isWithin_( ob.x3(), pTmp2->info.x3(), tolerance )
            )
         {
-          OctreeObj<H, T> * const  pTmp3  =  findIn_NWSE_SWNE_( ob, numOperations, tolerance, pTmp2 );
-          if ( true == isWithinTolerance_( ob, tolerance, pTmp3 ) )
+          OctreeObj<H, T, P, M> * const  pTmp3  =  findIn_NWSE_SWNE_( ob, stats, tolerance, pTmp2 );
+          if ( true == isWithinTolerance_( ob, tolerance, pTmp3, stats ) )
             return  pTmp3;
         }
       }
     if ( nullptr != pTmp->west
-      && tolerance >= std::abs( ob.x2() - pTmp->west->info.x2() )
+      && true == isWithin_( ob.x2(), pTmp->west->info.x2(), tolerance )
        )
     {
       pTmp  =  pTmp->west;
-      ++numOperations;
+      prefetch_( pTmp, 6 );
+      stats.hop( 1 );
     }
     else
       break;
@@ -695,132 +2365,535 @@ Octree<H,T>::findIn_WestEast_NWSE_SWNE_( const H<T>&              ob,
 }
 
 
-template<template<class> class  H, class T>
-OctreeObj<H, T> *
-Octree<H, T>::find( const H<T>&              ob,
-                    std::size_t&             numOperations,
-                    const T&                 tolerance,
-                    OctreeObj<H, T> * const  pInit
-                  ) const noexcept
+template<template<class> class  H, class T, class  P, bool  M>
+OctreeObj<H, T, P, M> *
+Octree<H, T, P, M>::find( const H<T>&                    ob,
+                          std::size_t&                   numOperations,
+                          const T&                       tolerance,
+                          OctreeObj<H, T, P, M> * const  pInit
+                        ) const noexcept
+{
+  OperationCounter  counter( numOperations );
+  return  find( ob, counter, tolerance, pInit );
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+template<class  S>
+OctreeObj<H, T, P, M> *
+Octree<H, T, P, M>::find( const H<T>&                    ob,
+                          S&                             stats,
+                          const T&                       tolerance,
+                          OctreeObj<H, T, P, M> * const  pInit
+                        ) const noexcept
 {
+  const StatsScope_<S>  scope( stats );
   if ( nullptr == root_
-    || ( ( typeid( double ) == typeid( tolerance )
-      || typeid( float ) == typeid( tolerance )
-      || typeid( int ) == typeid( tolerance ) )
-      && 0 > tolerance
-       )
+    || true == ToleranceCheck<T>::isNegative( tolerance )
      )
     return  root_;
 
-  OctreeObj<H, T> * pTmp  =  pInit;
+  if ( nullptr != pIndex_
+    && nullptr == pInit
+    && T( 0 ) == tolerance
+     )
+    return  pIndex_->find( ob );
+
+  OctreeObj<H, T, P, M> * pTmp  =  pInit;
   if ( nullptr == pInit )
     pTmp  =  root_;
 
-  if ( true == isWithinTolerance_( ob, tolerance, pTmp ) )
+  if ( T( 0 ) == tolerance )
+    return  findExact_( ob, stats, pTmp );
+
+  if ( true == isWithinTolerance_( ob, tolerance, pTmp, stats ) )
     return  pTmp;
 
-  if ( nullptr != pTmp
-    && tolerance >= std::abs( ob.x1() - pTmp->info.x1() )
-     )
+  if ( true == isWithin_( ob.x1(), pTmp->info.x1(), tolerance ) )
+    return  findInX1Window_( ob, stats, tolerance, pTmp );
+
+  // the walks to the south and to the north, every node they reach
+  // is checked on the way, so that the nodes they end at are not checked again:
+  OctreeObj<H, T, P, M> * const  pTmp1  =  pTmp;
+  while ( nullptr != pTmp->south
+       && false == isWithin_( ob.x1(), pTmp->info.x1(), tolerance )
+        )
   {
-    while ( nullptr != pTmp->south
-         && tolerance >= std::abs( ob.x1() - pTmp->south->info.x1() )
-          )
+    pTmp  =  pTmp->south;
+    prefetch_( pTmp, 0 );
+    stats.hop( 0 );
+    if ( true == isWithinTolerance_( ob, tolerance, pTmp, stats ) )
+      return  pTmp;
+  }
+  if ( true == isWithin_( ob.x1(), pTmp->info.x1(), tolerance ) )
+  {
+    const StatsScope_<S>  scopeSouth( stats );
+    OctreeObj<H, T, P, M> * const  pTmp2  =  findInX1Window_( ob, stats, tolerance, pTmp );
+    if ( nullptr != pTmp2 )
+      return  pTmp2;
+  }
+  // ********
+  pTmp  =  pTmp1;
+  while ( nullptr != pTmp->north
+       && false == isWithin_( ob.x1(), pTmp->info.x1(), tolerance )
+        )
+  {
+    pTmp  =  pTmp->north;
+    prefetch_( pTmp, 7 );
+    stats.hop( 0 );
+    if ( true == isWithinTolerance_( ob, tolerance, pTmp, stats ) )
+      return  pTmp;
+  }
+  if ( true == isWithin_( ob.x1(), pTmp->info.x1(), tolerance ) )
+  {
+    const StatsScope_<S>  scopeNorth( stats );
+    return  findInX1Window_( ob, stats, tolerance, pTmp );
+  }
+
+  return  nullptr; // not found
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+template<class  S>
+OctreeObj<H, T, P, M> *
+Octree<H, T, P, M>::findExact_( const H<T>&                    ob,
+                                S&                             stats,
+                                OctreeObj<H, T, P, M> * const  pInit
+                              ) const noexcept
+{
+  typedef  PointOrder<H, T>  Order;
+
+  if ( true == isSameElement_( ob, pInit, stats ) )
+    return  pInit;
+  const unsigned short     iLink  =  ( true == Order::template isLess<1>( ob, pInit->info ) ) ? 0 : 7;
+  OctreeObj<H, T, P, M> *  pTmp  =  pInit;
+  while ( nullptr != pTmp->link( iLink )
+       && false == Order::template isSamePrefix<1>( ob, pTmp->info )
+       && false == isPastX1_( ob, pTmp, iLink )
+        )
+  {
+    pTmp  =  pTmp->link( iLink );
+    prefetch_( pTmp, iLink );
+    stats.hop( 0 );
+    if ( true == isSameElement_( ob, pTmp, stats ) )
+      return  pTmp;
+  }
+  if ( false == Order::template isSamePrefix<1>( ob, pTmp->info ) )
+    return  nullptr; // not found
+
+  const StatsScope_<S>  scope( stats );
+  return  findInX1Window_( ob, stats, T( 0 ), pTmp );
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+template<class  S>
+OctreeObj<H, T, P, M> *
+Octree<H, T, P, M>::findInX1Window_( const H<T>&                    ob,
+                                     S&                             stats,
+                                     const T&                       tolerance,
+                                     OctreeObj<H, T, P, M> * const  pInit
+                                   ) const noexcept
+{
+  OctreeObj<H, T, P, M> *  pTmp  =  pInit;
+  while ( nullptr != pTmp->south
+       && true == isWithin_( ob.x1(), pTmp->south->info.x1(), tolerance )
+        )
+  {
+    pTmp  =  pTmp->south;
+    prefetch_( pTmp, 0 );
+    stats.hop( 0 );
+    if ( true == isWithinTolerance_( ob, tolerance, pTmp, stats ) )
+      return  pTmp;
+  }
+  do {
+    if ( nullptr != pTmp
+      && true == isWithin_( ob.x2(), pTmp->info.x2(), tolerance )
+       )
     {
-      pTmp  =  pTmp->south;
-      ++numOperations;
-      if ( true == isWithinTolerance_( ob, tolerance, pTmp ) )
-        return  pTmp;
+      OctreeObj<H, T, P, M> * const  pTmp3  =  findIn_WestEast_NWSE_SWNE_( ob, stats, tolerance, pTmp );
+      if ( true == isWithinTolerance_( ob, tolerance, pTmp3, stats ) )
+        return  pTmp3;
     }
-    do {
-      if ( nullptr != pTmp
-        && tolerance >= std::abs( ob.x2() - pTmp->info.x2() )
-         )
+    else
       {
-        OctreeObj<H, T> * const  pTmp3  =  findIn_WestEast_NWSE_SWNE_( ob, numOperations, tolerance, pTmp );
-        if ( true == isWithinTolerance_( ob, tolerance, pTmp3 ) )
-          return  pTmp3;
-      }
-      else
+        OctreeObj<H, T, P, M> * const  pTmp2  =  moveAlongWestEast_( ob, tolerance, pTmp, stats );
+        if ( true == isWithinTolerance_( ob, tolerance, pTmp2, stats ) )
+          return  pTmp2;
+        if ( nullptr != pTmp2
+          && true == isWithin_( ob.x1(), pTmp2->info.x1(), tolerance )
+          && true == isWithin_( ob.x2(), pTmp2->info.x2(), tolerance )
+           )
         {
-          OctreeObj<H, T> * const  pTmp2  =  moveAlongWestEast_( ob, tolerance, pTmp, numOperations );
-          if ( true == isWithinTolerance_( ob, tolerance, pTmp2 ) )
-            return  pTmp2;
-          if ( nullptr != pTmp2
-            && tolerance >= std::abs( ob.x1() - pTmp2->info.x1() )
-            && tolerance >= std::abs( ob.x2() - pTmp2->info.x2() )
-             )
-          {
-            OctreeObj<H, T> * const  pTmp3  =  findIn_WestEast_NWSE_SWNE_( ob, numOperations, tolerance, pTmp2 );
-            if ( true == isWithinTolerance_( ob, tolerance, pTmp3 ) )
-              return  pTmp3;
-          }
+          OctreeObj<H, T, P, M> * const  pTmp3  =  findIn_WestEast_NWSE_SWNE_( ob, stats, tolerance, pTmp2 );
+          if ( true == isWithinTolerance_( ob, tolerance, pTmp3, stats ) )
+            return  pTmp3;
         }
-      if ( nullptr != pTmp->north
-        && tolerance >= std::abs( ob.x1() - pTmp->north->info.x1() )
-         )
-      {
-        pTmp  =  pTmp->north;
-        ++numOperations;
-        if ( true == isWithinTolerance_( ob, tolerance, pTmp ) )
-          return  pTmp;
       }
-      else
-        break;
+    if ( nullptr != pTmp->north
+      && true == isWithin_( ob.x1(), pTmp->north->info.x1(), tolerance )
+       )
+    {
+      pTmp  =  pTmp->north;
+      prefetch_( pTmp, 7 );
+      stats.hop( 0 );
+      if ( true == isWithinTolerance_( ob, tolerance, pTmp, stats ) )
+        return  pTmp;
     }
-    while ( true );
+    else
+      break;
   }
-  else
+  while ( true );
+
+  return  nullptr; // not found
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+template<std::size_t  G>
+void
+Octree<H, T, P, M>::findBatch( const H<T> * const              obs,
+                               const T * const                 tolerances,
+                               const std::size_t&              num,
+                               OctreeObj<H, T, P, M> ** const  results
+                             ) const noexcept
+{
+  static_assert( 0 < G, "findBatch() needs at least one query in flight" );
+  BatchQuery_  aQueries[ G ];
+  std::size_t  numActive  =  0;
+  std::size_t  iNext  =  0;
+  while ( numActive < G
+       && iNext < num
+        )
+  {
+    BatchQuery_&  query  =  aQueries[ numActive ];
+    query.ob  =  obs + iNext;
+    query.tolerance  =  tolerances[ iNext ];
+    query.iQuery  =  iNext++;
+    if ( false == startBatchQuery_( query, results ) )
+      ++numActive;
+  }
+  // round robin, a finished query is replaced by the next one to start:
+  while ( 0 < numActive )
+    for ( std::size_t  i = 0; i < numActive; )
     {
-      OctreeObj<H, T> * const  pTmp1  =  pTmp;
-      while ( nullptr != pTmp->south
-           && tolerance < std::abs( ob.x1() - pTmp->info.x1() )
-            )
-      {
-        pTmp  =  pTmp->south;
-        ++numOperations;
-        if ( true == isWithinTolerance_( ob, tolerance, pTmp ) )
-          return  pTmp;
-      }
-      if ( nullptr != pTmp
-        && tolerance >= std::abs( ob.x1() - pTmp->info.x1() )
-         )
+      if ( false == stepBatchQuery_( aQueries[ i ], results ) )
       {
-        OctreeObj<H, T> * const  pTmp2  =  find( ob, numOperations, tolerance, pTmp );
-        if ( true == isWithinTolerance_( ob, tolerance, pTmp2 ) )
-          return  pTmp2;
+        ++i;
+        continue;
       }
-      // ********
-      pTmp  =  pTmp1;
-      while ( nullptr != pTmp->north
-           && tolerance < std::abs( ob.x1() - pTmp->info.x1() )
+      bool  isStarted  =  false;
+      while ( false == isStarted
+           && iNext < num
             )
       {
-        pTmp  =  pTmp->north;
-        ++numOperations;
-        if ( true == isWithinTolerance_( ob, tolerance, pTmp ) )
-          return  pTmp;
+        aQueries[ i ].ob  =  obs + iNext;
+        aQueries[ i ].tolerance  =  tolerances[ iNext ];
+        aQueries[ i ].iQuery  =  iNext++;
+        isStarted  =  ! startBatchQuery_( aQueries[ i ], results );
       }
-      if ( nullptr != pTmp
-        && tolerance >= std::abs( ob.x1() - pTmp->info.x1() )
+      if ( true == isStarted )
+        ++i;
+      else
+        aQueries[ i ]  =  aQueries[ --numActive ];
+    }
+}
+
+
+// the steps of find() down to the end of its walk along the North-South chain
+// of the root ( the queries within the tolerance of the root along x1
+// are searched at once ):
+template<template<class> class  H, class T, class  P, bool  M>
+bool
+Octree<H, T, P, M>::startBatchQuery_( BatchQuery_&  query, OctreeObj<H, T, P, M> ** const  results ) const noexcept
+{
+  NoQueryStats  stats;
+  const H<T>&  ob  =  *query.ob;
+  const T&  tolerance  =  query.tolerance;
+  OctreeObj<H, T, P, M> *&  result  =  results[ query.iQuery ];
+  if ( nullptr == root_
+    || true == ToleranceCheck<T>::isNegative( tolerance )
+     )
+  {
+    result  =  root_;
+    return  true;
+  }
+  if ( nullptr != pIndex_
+    && T( 0 ) == tolerance
+     )
+  {
+    result  =  pIndex_->find( ob );
+    return  true;
+  }
+  if ( true == isWithinTolerance_( ob, tolerance, root_, stats ) )
+  {
+    result  =  root_;
+    return  true;
+  }
+  if ( true == isWithin_( ob.x1(), root_->info.x1(), tolerance ) )
+  {
+    result  =  findInX1Window_( ob, stats, tolerance, root_ );
+    return  true;
+  }
+  query.pTmp  =  root_;
+  query.isExact  =  T( 0 ) == tolerance;
+  query.iLink  =  ( true == query.isExact && root_->info.x1() < ob.x1() ) ? 7 : 0;
+  prefetchNode_( root_->link( query.iLink ) );
+  return  false;
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+bool
+Octree<H, T, P, M>::stepBatchQuery_( BatchQuery_&  query, OctreeObj<H, T, P, M> ** const  results ) const noexcept
+{
+  NoQueryStats  stats;
+  const H<T>&  ob  =  *query.ob;
+  const T&  tolerance  =  query.tolerance;
+  OctreeObj<H, T, P, M> *&  result  =  results[ query.iQuery ];
+  OctreeObj<H, T, P, M> * const  pNext  =  query.pTmp->link( query.iLink );
+  if ( nullptr != pNext
+    && false == isWithin_( ob.x1(), query.pTmp->info.x1(), tolerance )
+    && ( false == query.isExact
+      || false == isPastX1_( ob, query.pTmp, query.iLink ) )
+     )
+  {
+    query.pTmp  =  pNext;
+    prefetchNode_( pNext->link( query.iLink ) );
+    if ( true == isWithinTolerance_( ob, tolerance, pNext, stats ) )
+    {
+      result  =  pNext;
+      return  true;
+    }
+    return  false;
+  }
+  // the end of the walk:
+  if ( true == isWithin_( ob.x1(), query.pTmp->info.x1(), tolerance ) )
+  {
+    OctreeObj<H, T, P, M> * const  pTmp2  =  findInX1Window_( ob, stats, tolerance, query.pTmp );
+    if ( nullptr != pTmp2 )
+    {
+      result  =  pTmp2;
+      return  true;
+    }
+  }
+  if ( 0 == query.iLink
+    && false == query.isExact
+     )
+  {
+    query.pTmp  =  root_;
+    query.iLink  =  7;
+    prefetchNode_( root_->north );
+    return  false;
+  }
+  result  =  nullptr;
+  return  true;
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+std::size_t
+Octree<H, T, P, M>::countWithin( const H<T>&  ob, const T&  tolerance ) const
+{
+  if ( nullptr == root_
+    || true == ToleranceCheck<T>::isNegative( tolerance )
+     )
+    return  0;
+  if ( false == isSlicesValid_ )
+  {
+    // a single reader refills the cache, the others wait for it:
+    while ( true == isSlicesBusy_.exchange( true ) )
+      std::this_thread::yield();
+    if ( false == isSlicesValid_ )
+      rebuildSlices_();
+    isSlicesBusy_  =  false;
+  }
+
+  // the nodes linked along the pair 'iPair' share the first 'iPair' coordinates
+  // and the chain is sorted by the next one, so that a link is not followed
+  // if one of the shared coordinates is out of the tolerance, or if the next one
+  // is out of it and the link leads farther away from 'ob'
+  // ( x1 is shared by the whole slice and within the tolerance already ):
+  auto  isPruned  =  [ & ] ( const OctreeObj<H, T, P, M> * const  q, const unsigned short  iLink ) {
+    const unsigned short  iPair  =  ( 4 > iLink ) ? iLink : 7 - iLink;
+    for ( unsigned short  k = 1; k < iPair; ++k )
+      if ( false == isWithin_( coordinate_( ob, k ), coordinate_( q->info, k ), tolerance ) )
+        return  true;
+    const T  x  =  coordinate_( q->info, iPair );
+    const T  y  =  coordinate_( ob, iPair );
+    if ( true == isWithin_( y, x, tolerance ) )
+      return  false;
+    return  ( 4 > iLink ) ? x < y : x > y;
+  };
+  std::size_t  num  =  0;
+  auto  visit  =  [ & ] ( const OctreeObj<H, T, P, M> * const  q ) {
+    for ( unsigned short  k = 1; k < 4; ++k )
+      if ( false == isWithin_( coordinate_( ob, k ), coordinate_( q->info, k ), tolerance ) )
+        return;
+    num  +=  q->count;
+  };
+
+  // the first slice not to the south of the x1 window:
+  typename std::vector<Slice_>::const_iterator  it  =
+    std::partition_point( slices_.begin(), slices_.end(), [ & ] ( const Slice_&  slice ) {
+      return  slice.x1 < ob.x1()
+           && false == isWithin_( ob.x1(), slice.x1, tolerance );
+    } );
+  for ( ; slices_.end() != it; ++it )
+  {
+    if ( false == isWithin_( ob.x1(), it->x1, tolerance ) )
+      break; // north of the window
+    bool  isInside  =  true;
+    bool  isOutside  =  false;
+    for ( unsigned short  k = 0; k < 3; ++k )
+    {
+      const T  y  =  coordinate_( ob, k + 1 );
+      const bool  isLoWithin  =  isWithin_( y, it->lo[ k ], tolerance );
+      const bool  isHiWithin  =  isWithin_( y, it->hi[ k ], tolerance );
+      if ( false == isLoWithin
+        || false == isHiWithin
+         )
+        isInside  =  false;
+      if ( ( false == isHiWithin && it->hi[ k ] < y )
+        || ( false == isLoWithin && it->lo[ k ] > y )
          )
+        isOutside  =  true;
+    }
+    if ( true == isInside )
+      num  +=  it->count;
+    else if ( false == isOutside )
+      walkSlice_( it->p, visit, isPruned );
+  }
+  return  num;
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+void
+Octree<H, T, P, M>::rebuildSlices_() const
+{
+  slices_.clear();
+  const OctreeObj<H, T, P, M>  *p  =  root_;
+  while ( nullptr != p->south )
+    p  =  p->south;
+  auto  isPruned  =  [] ( const OctreeObj<H, T, P, M> * const, const unsigned short ) {
+    return  false;
+  };
+  for ( ; nullptr != p; p  =  p->north )
+  {
+    Slice_  slice;
+    slice.p  =  p;
+    slice.x1  =  p->info.x1();
+    slice.count  =  0;
+    for ( unsigned short  k = 0; k < 3; ++k )
+    {
+      slice.lo[ k ]  =  coordinate_( p->info, k + 1 );
+      slice.hi[ k ]  =  slice.lo[ k ];
+    }
+    auto  visit  =  [ & ] ( const OctreeObj<H, T, P, M> * const  q ) {
+      slice.count  +=  q->count;
+      for ( unsigned short  k = 0; k < 3; ++k )
       {
-        OctreeObj<H, T> * const  pTmp2  =  find( ob, numOperations, tolerance, pTmp );
-        if ( true == isWithinTolerance_( ob, tolerance, pTmp2 ) )
-          return  pTmp2;
+        const T  x  =  coordinate_( q->info, k + 1 );
+        if ( x < slice.lo[ k ] )
+          slice.lo[ k ]  =  x;
+        if ( slice.hi[ k ] < x )
+          slice.hi[ k ]  =  x;
       }
+    };
+    walkSlice_( p, visit, isPruned );
+    slices_.push_back( slice );
+  }
+  isSlicesValid_  =  true;
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+template<class  V, class  F>
+void
+Octree<H, T, P, M>::walkSlice_( const OctreeObj<H, T, P, M> * const  pSlice, V&  visit, F&  isPruned ) const noexcept
+{
+  // the same depth-first walk as in clone(), the North-South chain
+  // is left at 'pSlice' ( the nodes below it may have North-South links
+  // of their own, all of them share the x1 of 'pSlice' ):
+  OctreePath<const OctreeObj<H, T, P, M> >  path;
+  const OctreeObj<H, T, P, M>  *p  =  pSlice;
+  visit( p );
+  unsigned short  iNext  =  0;
+  while ( true )
+  {
+    if ( 8 > iNext )
+    {
+      const unsigned short  iLink  =  iNext;
+      ++iNext;
+      if ( nullptr == p->link( iLink )
+        || path.parentLink() == iLink
+        || ( true == path.isAtRoot() && ( 0 == iLink || 7 == iLink ) )
+        || true == isPruned( p, iLink )
+         )
+        continue;
+      path.descend( p, iLink );
+      visit( p );
+      iNext  =  0;
+      continue;
     }
+    if ( true == path.isAtRoot() )
+      break;
+    const unsigned short  iLink  =  path.ascend( p );
+    iNext  =  iLink + 1;
+  }
+}
 
-  if ( true == isWithinTolerance_( ob, tolerance, pTmp ) )
-    return  pTmp;
 
-  return  nullptr; // not found
+template<template<class> class  H, class T, class  P, bool  M>
+bool
+Octree<H, T, P, M>::isInArena_( const OctreeObj<H, T, P, M> * const  p ) const noexcept
+{
+  const std::less<const OctreeObj<H, T, P, M> *>  less;
+  for ( const ArenaRef_ *  pRef = arenas_; nullptr != pRef; pRef = pRef->next )
+  {
+    const OctreeObj<H, T, P, M> * const  pBegin  =  pRef->pArena->nodes;
+    if ( false == less( p, pBegin )
+      && true == less( p, pBegin + pRef->pArena->numNodes )
+       )
+      return  true;
+  }
+  return  false;
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+void
+Octree<H, T, P, M>::releaseNode_( OctreeObj<H, T, P, M> * const  p ) noexcept
+{
+  if ( false == isInArena_( p ) )
+    delete  p;
+}
+
+
+template<template<class> class  H, class T, class  P, bool  M>
+void
+Octree<H, T, P, M>::releaseArenas_() noexcept
+{
+  while ( nullptr != arenas_ )
+  {
+    ArenaRef_ * const  pRef  =  arenas_;
+    arenas_  =  arenas_->next;
+    --pRef->pArena->numRefs;
+    if ( 0 == pRef->pArena->numRefs )
+    {
+      delete [] pRef->pArena->nodes;
+      delete  pRef->pArena;
+    }
+    delete  pRef;
+  }
 }
 
 
-template<template<class> class  H, class T>
+template<template<class> class  H, class T, class  P, bool  M>
 bool
-Octree<H, T>::checkEndNode_( const OctreeObj<H, T> * const  p ) const noexcept
+Octree<H, T, P, M>::checkEndNode_( const OctreeObj<H, T, P, M> * const  p ) const noexcept
 {
   if ( nullptr == p )
     return  true;
@@ -917,11 +2990,11 @@ Octree<H, T>::checkEndNode_( const OctreeObj<H, T> * const  p ) const noexcept
 }
 
 
-template<template<class> class  H, class T>
+template<template<class> class  H, class T, class  P, bool  M>
 void
-Octree<H, T>::getRootToEndNode_() noexcept
+Octree<H, T, P, M>::getRootToEndNode_() noexcept
 {
-    OctreeObj<H, T> * pPrev  =  root_;
+    OctreeObj<H, T, P, M> * pPrev  =  root_;
     while ( false == checkEndNode_( root_ ) )
     {
       if ( nullptr != root_->north
@@ -999,9 +3072,9 @@ Octree<H, T>::getRootToEndNode_() noexcept
     } // white ()
 }
 
-template<template<class> class  H, class T>
+template<template<class> class  H, class T, class  P, bool  M>
 void
-Octree<H, T>::deleteEndNodes_() noexcept
+Octree<H, T, P, M>::deleteEndNodes_() noexcept
 {
     // if the tree is linear / chain:
     while ( true == checkEndNode_( root_ )
@@ -1013,7 +3086,7 @@ Octree<H, T>::deleteEndNodes_() noexcept
          )
       {
         root_  =  root_->north;
-        delete  root_->south;
+        releaseNode_( root_->south );
         root_->south  =  nullptr;
         if ( false == checkEndNode_( root_ ) )
           return;
@@ -1023,7 +3096,7 @@ Octree<H, T>::deleteEndNodes_() noexcept
          )
       {
         root_  =  root_->south;
-        delete  root_->north;
+        releaseNode_( root_->north );
         root_->north  =  nullptr;
 	if ( false == checkEndNode_( root_ ) )
           return;
@@ -1033,7 +3106,7 @@ Octree<H, T>::deleteEndNodes_() noexcept
          )
       {
         root_  =  root_->west;
-        delete  root_->east;
+        releaseNode_( root_->east );
         root_->east  =  nullptr;
 	if ( false == checkEndNode_( root_ ) )
           return;
@@ -1043,7 +3116,7 @@ Octree<H, T>::deleteEndNodes_() noexcept
          )
       {
         root_  =  root_->east;
-        delete  root_->west;
+        releaseNode_( root_->west );
         root_->west  =  nullptr;
 	if ( false == checkEndNode_( root_ ) )
           return;
@@ -1053,7 +3126,7 @@ Octree<H, T>::deleteEndNodes_() noexcept
          )
       {
         root_  =  root_->nw;
-        delete  root_->se;
+        releaseNode_( root_->se );
         root_->se  =  nullptr;
 	if ( false == checkEndNode_( root_ ) )
           return;
@@ -1063,7 +3136,7 @@ Octree<H, T>::deleteEndNodes_() noexcept
          )
       {
         root_  =  root_->ne;
-        delete  root_->sw;
+        releaseNode_( root_->sw );
         root_->sw  =  nullptr;
 	if ( false == checkEndNode_( root_ ) )
           return;
@@ -1073,7 +3146,7 @@ Octree<H, T>::deleteEndNodes_() noexcept
          )
       {
         root_  =  root_->sw;
-        delete  root_->ne;
+        releaseNode_( root_->ne );
         root_->ne  =  nullptr;
 	if ( false == checkEndNode_( root_ ) )
           return;
@@ -1083,7 +3156,7 @@ Octree<H, T>::deleteEndNodes_() noexcept
          )
       {
         root_  =  root_->se;
-        delete  root_->nw;
+        releaseNode_( root_->nw );
         root_->nw  =  nullptr;
 	if ( false == checkEndNode_( root_ ) )
           return;
@@ -1093,9 +3166,9 @@ Octree<H, T>::deleteEndNodes_() noexcept
 
 
 
-template<template<class> class  H, class T>
+template<template<class> class  H, class T, class  P, bool  M>
 void
-Octree<H, T>::print_( OctreeObj<H, T> *  p ) const noexcept
+Octree<H, T, P, M>::print_( OctreeObj<H, T, P, M> *  p ) const noexcept
 {
   if ( nullptr == p )
     p  =  root_;
@@ -1210,4 +3283,96 @@ comparePoints( const Point<T>&  a, const Point<T>&  b ) noexcept
   return  false;
 }
 
+// a point of four integer coordinates of at most 16 bits ( e.g. quantized
+// ones, see QuantizedOctree ) packed into a single 64-bit key: x1 takes the highest
+// 16 bits and x4 the lowest ones, each biased to an unsigned value, so that
+// the keys are ordered as comparePoints() orders the points;
+// Octree::insert() then decides the chain to follow with one or two
+// integer comparisons of the keys instead of up to four comparisons of the coordinates,
+// and Octree::find() with a tolerance of 0 compares the keys along the North-South
+// chain; the walks within a tolerance and within the slice of an x1 compare the
+// coordinates; there is no such point for float or double: four of them do not
+// fit into one key, and a key per coordinate compares no faster than the coordinate:
+template<class T>
+struct  PackedPoint {
+    static_assert( std::is_integral<T>::value && 2 >= sizeof( T ),
+                   "the coordinates of a PackedPoint must be integers of at most 16 bits" );
+  public:
+    PackedPoint() : key_( pack_( 0, 0, 0, 0 ) ) { }
+    PackedPoint( const T&  xIn,
+                 const T&  yIn,
+                 const T&  zIn,
+                 const T&  tIn
+               ) : key_( pack_( xIn, yIn, zIn, tIn ) ) { }
+    T  x1() const { return  unpack_( 48 ); }
+    T  x2() const { return  unpack_( 32 ); }
+    T  x3() const { return  unpack_( 16 ); }
+    T  x4() const { return  unpack_( 0 ); }
+    std::uint64_t  key() const { return  key_; }
+    friend bool  operator==( const PackedPoint&  a, const PackedPoint&  b ) noexcept
+    {
+      return  a.key_ == b.key_;
+    }
+    friend T  dist( const PackedPoint&  a, const PackedPoint&  b ) noexcept
+    {
+      return  ( std::abs( a.x1() - b.x1() )
+              + std::abs( a.x2() - b.x2() )
+              + std::abs( a.x3() - b.x3() )
+              + std::abs( a.x4() - b.x4() ) );
+    }
+  private:
+    static constexpr long  bias_  =  std::is_signed<T>::value ? 32768 : 0;
+    static std::uint64_t  pack_( const T&  x1, const T&  x2, const T&  x3, const T&  x4 ) noexcept
+    {
+      return  ( static_cast<std::uint64_t>( x1 + bias_ ) << 48 )
+            | ( static_cast<std::uint64_t>( x2 + bias_ ) << 32 )
+            | ( static_cast<std::uint64_t>( x3 + bias_ ) << 16 )
+            |   static_cast<std::uint64_t>( x4 + bias_ );
+    }
+    T  unpack_( const unsigned short  shift ) const noexcept
+    {
+      return  static_cast<T>( static_cast<long>( ( key_ >> shift ) & 0xFFFF ) - bias_ );
+    }
+  private:
+    std::uint64_t  key_;
+};
+
+// the bits of the keys of PackedPoint holding the first 'n' coordinates:
+constexpr std::uint64_t
+packedPrefixMask( const unsigned short  n ) noexcept
+{
+  return  ( 0 == n ) ? 0 : ~std::uint64_t( 0 ) << ( 64 - 16 * n );
+}
+
+template<class T>
+struct  PointOrder<PackedPoint, T> {
+  template<unsigned short  N>
+  static bool  isSamePrefix( const PackedPoint<T>&  a, const PackedPoint<T>&  b ) noexcept
+  {
+    return  0 == ( ( a.key() ^ b.key() ) & packedPrefixMask( N ) );
+  }
+  template<unsigned short  N>
+  static bool  isNotLess( const PackedPoint<T>&  a, const PackedPoint<T>&  b ) noexcept
+  {
+    return  ( a.key() & packedPrefixMask( N ) ) >= ( b.key() & packedPrefixMask( N ) )
+         && true == isSamePrefix<N - 1>( a, b );
+  }
+  template<unsigned short  N>
+  static bool  isLess( const PackedPoint<T>&  a, const PackedPoint<T>&  b ) noexcept
+  {
+    return  ( a.key() & packedPrefixMask( N ) ) < ( b.key() & packedPrefixMask( N ) )
+         && true == isSamePrefix<N - 1>( a, b );
+  }
+};
+
+// the 'comparePoints' order of the packed points:
+template<class T>
+bool
+comparePackedPoints( const PackedPoint<T>&  a, const PackedPoint<T>&  b ) noexcept
+{
+  return  a.key() < b.key();
+}
+
 } // namespace  d7cA
+
+#endif // OCTREE_DIDACTIC_OCTREE_HPP
@@ -0,0 +1,228 @@
+// This file is a part of the 'octree.didactic' project
+//
+// author : uri.heap  <u.heep@tutanota.com>
+//
+// license : GPL.v3+
+
+
+#ifndef  OCTREE_DIDACTIC_QUANTIZED_OCTREE_HPP
+#define  OCTREE_DIDACTIC_QUANTIZED_OCTREE_HPP
+
+#include "octree.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace  d7cA {
+
+// an Octree of the elements H<T> stored as H<Q>, where Q is a signed integer:
+// a coordinate 'x(k)' within the range [ lo[k], hi[k] ] given to the constructor
+// is stored as round( ( x(k) - offset(k) ) * scale ), where 'offset(k)' is
+// the centre of the range and 'scale' is shared by all the axes, so that
+// a tolerance is converted once per query;
+// the widest range is mapped onto a quarter of the range of Q, so that
+// the difference of a stored coordinate and a query within the tolerance
+// of the ranges never overflows Q;
+// a stored coordinate outside of its range is clamped to it;
+//
+// the error bound: a coordinate within its range restored by dequantize()
+// is within getResolution() / 2 of the original one ( getResolution() is 1 / scale );
+// find() never misses an element within the tolerance of the query
+// ( along every axis ), and an element it returns is at most
+// 2 * getResolution() farther than the tolerance along any axis;
+// a tolerance wider than the widest range is narrowed down to that range;
+// the Octree underneath is in the multiset mode for M = true:
+template<template<class> class  H, class  T, class  Q = std::int16_t, bool  M = false>
+class  QuantizedOctree {
+    static_assert( std::is_integral<Q>::value && std::is_signed<Q>::value,
+                   "the quantized coordinates must be signed integers" );
+    static_assert( std::is_floating_point<T>::value,
+                   "the coordinates to quantize must be floating point" );
+  public:
+    QuantizedOctree( const T  (&lo)[ 4 ],
+                     const T  (&hi)[ 4 ]
+                   ) noexcept;
+    // quantizes a copy of 'arr', the array itself is left untouched:
+    void  init( const H<T> * const  arr, const long&  num, bool (*foo)( const H<Q>&, const H<Q>& ) );
+    void  insert( const H<T>&  obj ) noexcept;
+    // the stored ( quantized ) element found, use dequantize() to restore it;
+    // 'stats' is passed on to Octree::find():
+    template<class  S>
+    const OctreeObj<H, Q, void, M> *  find( const H<T>&  ob, S&  stats, const T&  tolerance = 0 ) const noexcept;
+    H<Q>  quantize( const H<T>&  ob ) const noexcept;
+    H<T>  dequantize( const H<Q>&  ob ) const noexcept;
+    // the smallest integer tolerance covering 'tolerance' after rounding
+    // ( -1 for a negative one ):
+    Q  quantizeTolerance( const T&  tolerance ) const noexcept;
+    // the distance between two neighbouring stored values:
+    const T&  getResolution() const noexcept;
+    const Octree<H, Q, void, M>&  getOctree() const noexcept;
+  private:
+    // the coordinate 'x' along the axis 'k' scaled and rounded, not clamped:
+    T  round_( const T&  x, const unsigned short  k ) const noexcept;
+    Q  quantize_( const T&  x, const unsigned short  k ) const noexcept;
+  private:
+    static constexpr Q  maxQ_  =  std::numeric_limits<Q>::max() / 4;
+    T                      offsets_[ 4 ];
+    // the largest stored coordinates along the axes:
+    T                      limits_[ 4 ];
+    T                      scale_;
+    T                      resolution_;
+    Octree<H, Q, void, M>  octree_;
+};
+
+
+template<template<class> class  H, class  T, class  Q, bool  M>
+constexpr Q  QuantizedOctree<H, T, Q, M>::maxQ_;
+
+
+template<template<class> class  H, class  T, class  Q, bool  M>
+QuantizedOctree<H, T, Q, M>::QuantizedOctree( const T  (&lo)[ 4 ],
+                                              const T  (&hi)[ 4 ]
+                                            ) noexcept : offsets_(),
+                                                         limits_(),
+                                                         scale_( 1 ),
+                                                         resolution_( 1 ),
+                                                         octree_()
+{
+  T  halfRangeMax  =  0;
+  for ( unsigned short  k = 0; k < 4; ++k )
+  {
+    offsets_[ k ]  =  ( lo[ k ] + hi[ k ] ) / 2;
+    halfRangeMax  =  std::max( halfRangeMax, std::abs( hi[ k ] - lo[ k ] ) / 2 );
+  }
+  if ( 0 < halfRangeMax )
+  {
+    scale_  =  maxQ_ / halfRangeMax;
+    resolution_  =  1 / scale_;
+  }
+  for ( unsigned short  k = 0; k < 4; ++k )
+    limits_[ k ]  =  std::min<T>( maxQ_, std::floor( std::abs( hi[ k ] - lo[ k ] ) / 2 * scale_ + T( 0.5 ) ) );
+}
+
+
+template<template<class> class  H, class  T, class  Q, bool  M>
+T
+QuantizedOctree<H, T, Q, M>::round_( const T&  x, const unsigned short  k ) const noexcept
+{
+  return  std::floor( ( x - offsets_[ k ] ) * scale_ + T( 0.5 ) );
+}
+
+
+template<template<class> class  H, class  T, class  Q, bool  M>
+Q
+QuantizedOctree<H, T, Q, M>::quantize_( const T&  x, const unsigned short  k ) const noexcept
+{
+  const T  v  =  round_( x, k );
+  if ( v > limits_[ k ] )
+    return  static_cast<Q>( limits_[ k ] );
+  if ( v < -limits_[ k ] )
+    return  static_cast<Q>( -limits_[ k ] );
+  return  static_cast<Q>( v );
+}
+
+
+template<template<class> class  H, class  T, class  Q, bool  M>
+H<Q>
+QuantizedOctree<H, T, Q, M>::quantize( const H<T>&  ob ) const noexcept
+{
+  return  H<Q>( quantize_( ob.x1(), 0 ), quantize_( ob.x2(), 1 ), quantize_( ob.x3(), 2 ), quantize_( ob.x4(), 3 ) );
+}
+
+
+template<template<class> class  H, class  T, class  Q, bool  M>
+H<T>
+QuantizedOctree<H, T, Q, M>::dequantize( const H<Q>&  ob ) const noexcept
+{
+  return  H<T>( offsets_[ 0 ] + ob.x1() * resolution_,
+                offsets_[ 1 ] + ob.x2() * resolution_,
+                offsets_[ 2 ] + ob.x3() * resolution_,
+                offsets_[ 3 ] + ob.x4() * resolution_ );
+}
+
+
+template<template<class> class  H, class  T, class  Q, bool  M>
+Q
+QuantizedOctree<H, T, Q, M>::quantizeTolerance( const T&  tolerance ) const noexcept
+{
+  // two roundings move the difference of two coordinates by less than 1:
+  if ( 0 > tolerance )
+    return  -1;
+  const T  v  =  std::floor( tolerance * scale_ ) + 1;
+  if ( v > 2 * maxQ_ )
+    return  2 * maxQ_;
+  return  static_cast<Q>( v );
+}
+
+
+template<template<class> class  H, class  T, class  Q, bool  M>
+void
+QuantizedOctree<H, T, Q, M>::init( const H<T> * const  arr,
+                                   const long&         num,
+                                   bool (*foo)( const H<Q>&, const H<Q>& )
+                                 )
+{
+  std::vector<H<Q> >  vecQuantized;
+  vecQuantized.reserve( static_cast<std::size_t>( std::max( 0L, num ) ) );
+  for ( long  i = 0; i < num; ++i )
+    vecQuantized.push_back( quantize( arr[ i ] ) );
+  octree_.init( vecQuantized.data(), num, foo );
+}
+
+
+template<template<class> class  H, class  T, class  Q, bool  M>
+void
+QuantizedOctree<H, T, Q, M>::insert( const H<T>&  obj ) noexcept
+{
+  octree_.insert( quantize( obj ) );
+}
+
+
+template<template<class> class  H, class  T, class  Q, bool  M>
+template<class  S>
+const OctreeObj<H, Q, void, M> *
+QuantizedOctree<H, T, Q, M>::find( const H<T>&  ob, S&  stats, const T&  tolerance ) const noexcept
+{
+  const Q  toleranceQ  =  quantizeTolerance( tolerance );
+  if ( 0 > toleranceQ )
+    return  nullptr;
+  // a query farther than the tolerance from a range has no match,
+  // a closer one is not clamped ( that could bring it within the tolerance
+  // of an element it is far from ):
+  Q  x[ 4 ];
+  const T  aX[ 4 ]  =  { ob.x1(), ob.x2(), ob.x3(), ob.x4() };
+  for ( unsigned short  k = 0; k < 4; ++k )
+  {
+    const T  v  =  round_( aX[ k ], k );
+    if ( v > limits_[ k ] + toleranceQ
+      || v < -limits_[ k ] - toleranceQ
+       )
+      return  nullptr;
+    x[ k ]  =  static_cast<Q>( v );
+  }
+  return  octree_.find( H<Q>( x[ 0 ], x[ 1 ], x[ 2 ], x[ 3 ] ), stats, toleranceQ );
+}
+
+
+template<template<class> class  H, class  T, class  Q, bool  M>
+const T&
+QuantizedOctree<H, T, Q, M>::getResolution() const noexcept
+{
+  return  resolution_;
+}
+
+
+template<template<class> class  H, class  T, class  Q, bool  M>
+const Octree<H, Q, void, M>&
+QuantizedOctree<H, T, Q, M>::getOctree() const noexcept
+{
+  return  octree_;
+}
+
+} // namespace  d7cA
+
+#endif // OCTREE_DIDACTIC_QUANTIZED_OCTREE_HPP
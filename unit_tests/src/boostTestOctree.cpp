@@ -9,9 +9,115 @@
 #include <boost/test/unit_test.hpp>
 
 #include "octree.hpp"
+#include "quantizedOctree.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+// the access of testOctree12 to the private traversal routines,
+// all of them start at the root of the tree:
+struct  TraversalTest {};
+
+namespace  d7cA {
+
+template<>
+class  OctreeAccess<TraversalTest> {
+  public:
+    typedef  Octree<Point, double>     Tree;
+    typedef  OctreeObj<Point, double>  Node;
+    static Node *  moveAlongWestEast( const Tree&  tree, const Point<double>&  ob, const double&  tolerance, QueryStats&  stats )
+    {
+      return  tree.moveAlongWestEast_( ob, tolerance, tree.root_, stats );
+    }
+    static Node *  moveAlongNWSE( const Tree&  tree, const Point<double>&  ob, const double&  tolerance, QueryStats&  stats )
+    {
+      return  tree.moveAlongNWSE_( ob, tolerance, tree.root_, stats );
+    }
+    static Node *  moveAlongSWNE( const Tree&  tree, const Point<double>&  ob, const double&  tolerance, QueryStats&  stats )
+    {
+      return  tree.moveAlongSWNE_( ob, tolerance, tree.root_, stats );
+    }
+    static Node *  findInNWSESWNE( const Tree&  tree, const Point<double>&  ob, const double&  tolerance, QueryStats&  stats )
+    {
+      return  tree.findIn_NWSE_SWNE_( ob, stats, tolerance, tree.root_ );
+    }
+    static Node *  findInWestEastNWSESWNE( const Tree&  tree, const Point<double>&  ob, const double&  tolerance, QueryStats&  stats )
+    {
+      return  tree.findIn_WestEast_NWSE_SWNE_( ob, stats, tolerance, tree.root_ );
+    }
+};
+
+} // namespace d7cA
+
+
+// the access of testOctree21 to the split() that counts the nodes it visits:
+struct  SplitCostTest {};
+
+namespace  d7cA {
+
+template<>
+class  OctreeAccess<SplitCostTest> {
+  public:
+    typedef  Octree<Point, double>  Tree;
+    static Tree  split( Tree&  tree, const double&  pivot, std::size_t&  numVisited )
+    {
+      return  tree.split_( pivot, numVisited );
+    }
+};
+
+} // namespace d7cA
+
+
+// find() against a brute-force std::find_if() over 'vecPoints' for random
+// queries and tolerances ( testOctree23 ); the number of queries whose x1 lies
+// beyond the tolerance south and north of the root is added up, so that the
+// walks to both sides are known to be exercised:
+static
+void
+checkFindAgainstFindIf( const d7cA::Octree<d7cA::Point, double>&  octree,
+                        const std::vector<d7cA::Point<double> >&  vecPoints,
+                        std::mt19937&                             gen,
+                        std::size_t&                              numSouth,
+                        std::size_t&                              numNorth
+                      )
+{
+  std::uniform_int_distribution<>  dist( -8, +8 );
+  std::uniform_int_distribution<>  distTolerance( 0, 3 );
+  d7cA::NoQueryStats  stats;
+  const d7cA::OctreeObj<d7cA::Point, double> * const  pRoot  =  octree.find( vecPoints[ 0 ], stats, -1. );
+  BOOST_REQUIRE( nullptr != pRoot );
+  for ( int  iQuery = 0; iQuery < 400; ++iQuery )
+  {
+    const d7cA::Point<double>  ob( dist( gen ), dist( gen ) / 2, dist( gen ) / 2, dist( gen ) / 2 );
+    const double  tolerance  =  distTolerance( gen );
+    auto  isWithin  =  [ & ] ( const d7cA::Point<double>&  p )
+                       {
+                         return  tolerance >= std::abs( p.x1() - ob.x1() )
+                              && tolerance >= std::abs( p.x2() - ob.x2() )
+                              && tolerance >= std::abs( p.x3() - ob.x3() )
+                              && tolerance >= std::abs( p.x4() - ob.x4() );
+                       };
+    const bool  isThere  =  vecPoints.end() != std::find_if( vecPoints.begin(), vecPoints.end(), isWithin );
+    const d7cA::OctreeObj<d7cA::Point, double> * const  pFound  =  octree.find( ob, stats, tolerance );
+    BOOST_CHECK_EQUAL( nullptr != pFound, isThere );
+    if ( nullptr != pFound )
+      BOOST_CHECK( true == isWithin( pFound->info ) );
+    if ( ob.x1() + tolerance < pRoot->info.x1() )
+      ++numSouth;
+    if ( ob.x1() - tolerance > pRoot->info.x1() )
+      ++numNorth;
+  }
+}
 
 
 BOOST_AUTO_TEST_SUITE( testOctree )
@@ -484,7 +590,7 @@ BOOST_AUTO_TEST_CASE( testOctree2 )
   arrPoints[ 9 ]  =  d7cA::Point<double>( 36, 39, -26, -10 );
 
   // numbers of shifts through the tree to find the corresponding elements:
-  constexpr std::size_t  aNumOperations[ numPoints ]  =  { 3, 2, 1, 0, 4, 5, 6, 7, 8, 9 };
+  constexpr std::size_t  aNumOperations[ numPoints ]  =  { 3, 2, 1, 0, 1, 2, 3, 4, 5, 6 };
 
   d7cA::Octree<d7cA::Point, double>  octree;
   octree.init( arrPoints, numPoints, d7cA::comparePoints<double> );
@@ -626,7 +732,7 @@ BOOST_AUTO_TEST_CASE( testOctree4 )
   arrPoints[ 52 ]  =  d7cA::Point<double>( 0, 0, 0, -1 );
 
   // numbers of shifts through the tree to find the corresponding elements:
-  constexpr std::size_t  aNumOperations[ numPoints ]  =  { 1, 2, 3, 2, 3, 4, 5, 2, 3, 4, 5, 4, 5, 6, 7, 0, 1, 2, 1, 2, 3, 4, 1, 2, 3, 2, 3, 4, 3, 4, 5, 2, 3, 4, 3, 4, 5, 6, 2, 3, 4, 3, 4, 5, 6, 3, 4, 5, 6, 5, 6, 7, 8 };
+  constexpr std::size_t  aNumOperations[ numPoints ]  =  { 1, 2, 3, 2, 3, 4, 5, 2, 3, 4, 5, 4, 5, 6, 7, 0, 1, 2, 1, 2, 3, 4, 1, 2, 3, 2, 3, 4, 3, 4, 5, 2, 3, 4, 3, 4, 5, 6, 1, 2, 3, 2, 3, 4, 5, 2, 3, 4, 5, 4, 5, 6, 7 };
 
   d7cA::Octree<d7cA::Point, double>  octree;
   octree.init( arrPoints, numPoints, d7cA::comparePoints<double> );
@@ -650,4 +756,1308 @@ BOOST_AUTO_TEST_CASE( testOctree4 )
 }
 
 
+BOOST_AUTO_TEST_CASE( testOctree5 )
+{
+  constexpr std::size_t  numPoints  =  8;
+  d7cA::Point<double>   arrPoints[ numPoints ];
+
+  arrPoints[ 0 ]  =  d7cA::Point<double>( 1, 2, 3, 4 );
+  arrPoints[ 1 ]  =  d7cA::Point<double>( 1, 2, 3, 4 );
+  arrPoints[ 2 ]  =  d7cA::Point<double>( 1, 2, 3, 5 );
+  arrPoints[ 3 ]  =  d7cA::Point<double>( -7, 0, 0, 0 );
+  arrPoints[ 4 ]  =  d7cA::Point<double>( 1, 2, 3, 4 );
+  arrPoints[ 5 ]  =  d7cA::Point<double>( -7, 0, 0, 0 );
+  arrPoints[ 6 ]  =  d7cA::Point<double>( 9, 1, 1, 1 );
+  arrPoints[ 7 ]  =  d7cA::Point<double>( 1, -2, 3, 4 );
+
+  // multiplicities of the elements listed above:
+  constexpr unsigned long  aCount[ numPoints ]  =  { 3, 3, 1, 2, 3, 2, 1, 1 };
+
+  d7cA::Octree<d7cA::Point, double, void, true>  octreeMultiset;
+  BOOST_CHECK( true == octreeMultiset.isMultiset() );
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    octreeMultiset.insert( arrPoints[ i ] );
+
+  // the duplicates are counted:
+  BOOST_CHECK_EQUAL( octreeMultiset.getNumElements(), numPoints );
+
+  // NOTE: Octree::init() sorts the array passed to it:
+  d7cA::Point<double>   arrPointsSorted[ numPoints ];
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    arrPointsSorted[ i ]  =  arrPoints[ i ];
+
+  d7cA::Octree<d7cA::Point, double>  octree;
+  BOOST_CHECK( false == octree.isMultiset() );
+  octree.init( arrPointsSorted, numPoints, d7cA::comparePoints<double> );
+  BOOST_CHECK_EQUAL( octree.getNumElements(), numPoints );
+
+  for ( std::size_t i = 0; i < numPoints; ++i )
+  {
+    const d7cA::Point<double>  p  =  arrPoints[ i ];
+    std::size_t  numOperations  =  0;
+    const d7cA::OctreeObj<d7cA::Point, double, void, true> * const  result  =  octreeMultiset.find( p, numOperations );
+
+    BOOST_CHECK( nullptr != result );
+    if ( nullptr != result )
+    {
+      BOOST_CHECK( p == result->info );
+      BOOST_CHECK_EQUAL( result->count, aCount[ i ] );
+    }
+
+    // without the multiset mode every duplicate is a separate node:
+    const d7cA::OctreeObj<d7cA::Point, double> * const  result1  =  octree.find( p, numOperations );
+    BOOST_CHECK( nullptr != result1 );
+    if ( nullptr != result1 )
+      BOOST_CHECK_EQUAL( result1->count, 1 );
+  }
+}
+
+
+BOOST_AUTO_TEST_CASE( testOctree6 )
+{
+  const d7cA::Octree<d7cA::Point, double>  octreeEmpty;
+  BOOST_CHECK( octreeEmpty.begin() == octreeEmpty.end() );
+
+  d7cA::Octree<d7cA::Point, double>  octreeSingle;
+  octreeSingle.insert( d7cA::Point<double>( 1, 2, 3, 4 ) );
+  d7cA::Octree<d7cA::Point, double>::const_iterator  it  =  octreeSingle.begin();
+  BOOST_CHECK( it != octreeSingle.end() );
+  BOOST_CHECK( d7cA::Point<double>( 1, 2, 3, 4 ) == it->info );
+  ++it;
+  BOOST_CHECK( it == octreeSingle.end() );
+
+  std::random_device  rd;
+  std::mt19937        gen( rd() );
+  // a small range of integral values produces many shared coordinates:
+  std::uniform_int_distribution<>   dist( -3, +3 );
+  constexpr std::size_t  numPoints  =  2000;
+  d7cA::Point<double>  * arrPoints  =  new d7cA::Point<double> [ numPoints ];
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    arrPoints[ i ]  =  d7cA::Point<double>( dist( gen ), dist( gen ), dist( gen ), dist( gen ) );
+
+  d7cA::Octree<d7cA::Point, double>  octree;
+  octree.init( arrPoints, numPoints, d7cA::comparePoints<double> );
+
+  // the elements are visited in the order of the sorted array:
+  std::size_t  numVisited  =  0;
+  for ( const d7cA::OctreeObj<d7cA::Point, double>&  obj : octree )
+  {
+    if ( numPoints > numVisited )
+      BOOST_CHECK( arrPoints[ numVisited ] == obj.info );
+    ++numVisited;
+  }
+  BOOST_CHECK_EQUAL( numVisited, numPoints );
+
+  // the multiplicities add up to the number of elements:
+  d7cA::Octree<d7cA::Point, double, void, true>  octreeMultiset;
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    octreeMultiset.insert( arrPoints[ i ] );
+  unsigned long  numCounted  =  0;
+  std::size_t  numNodes  =  0;
+  for ( d7cA::Octree<d7cA::Point, double, void, true>::const_iterator  itM = octreeMultiset.begin(); itM != octreeMultiset.end(); itM++ )
+  {
+    numCounted  +=  itM->count;
+    ++numNodes;
+  }
+  BOOST_CHECK_EQUAL( numCounted, octreeMultiset.getNumElements() );
+  BOOST_CHECK( numNodes <= numPoints );
+
+  delete [] arrPoints;
+  arrPoints  =  nullptr;
+}
+
+
+// a clone of 'octree' holds the same elements in the same order,
+// it finds the same nodes and is independent from 'octree' ( testOctree7 ):
+template<bool  M>
+static
+void
+checkClone( const d7cA::Octree<d7cA::Point, double, void, M>&  octree, const d7cA::Point<double> * const  arrPoints, const std::size_t  numPoints )
+{
+  d7cA::Octree<d7cA::Point, double, void, M>  octreeClone  =  octree.clone();
+  BOOST_CHECK_EQUAL( octreeClone.getNumElements(), octree.getNumElements() );
+  BOOST_CHECK_EQUAL( octreeClone.getNumNodes(), octree.getNumNodes() );
+
+  // the clone holds the same elements in the same order:
+  typename d7cA::Octree<d7cA::Point, double, void, M>::const_iterator  it  =  octree.begin();
+  for ( const d7cA::OctreeObj<d7cA::Point, double, void, M>&  obj : octreeClone )
+  {
+    BOOST_CHECK( it != octree.end() );
+    if ( it == octree.end() )
+      break;
+    BOOST_CHECK( it->info == obj.info );
+    BOOST_CHECK_EQUAL( it->count, obj.count );
+    BOOST_CHECK( &*it != &obj );
+    ++it;
+  }
+  BOOST_CHECK( it == octree.end() );
+
+  // the same search results with the same numbers of operations:
+  for ( std::size_t i = 0; i < numPoints; ++i )
+  {
+    std::size_t  numOperations  =  0;
+    std::size_t  numOperationsClone  =  0;
+    const d7cA::OctreeObj<d7cA::Point, double, void, M> * const  result  =  octree.find( arrPoints[ i ], numOperations, 0.5 );
+    const d7cA::OctreeObj<d7cA::Point, double, void, M> * const  resultClone  =  octreeClone.find( arrPoints[ i ], numOperationsClone, 0.5 );
+    BOOST_CHECK( ( nullptr == result ) == ( nullptr == resultClone ) );
+    if ( nullptr != result
+      && nullptr != resultClone
+       )
+      BOOST_CHECK( result->info == resultClone->info );
+    BOOST_CHECK_EQUAL( numOperations, numOperationsClone );
+  }
+
+  // the clone is independent from the original tree:
+  octreeClone.insert( d7cA::Point<double>( 100, 100, 100, 100 ) );
+  BOOST_CHECK_EQUAL( octreeClone.getNumElements(), octree.getNumElements() + 1 );
+}
+
+
+BOOST_AUTO_TEST_CASE( testOctree7 )
+{
+  std::random_device  rd;
+  std::mt19937        gen( rd() );
+  std::uniform_int_distribution<>   dist( -5, +5 );
+  constexpr std::size_t  numPoints  =  1000;
+  d7cA::Point<double>  * arrPoints  =  new d7cA::Point<double> [ numPoints ];
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    arrPoints[ i ]  =  d7cA::Point<double>( dist( gen ), dist( gen ), dist( gen ), dist( gen ) );
+
+  // trees can be stored in a container:
+  std::vector<d7cA::Octree<d7cA::Point, double> >  vecOctrees;
+  vecOctrees.push_back( d7cA::Octree<d7cA::Point, double>() );
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    vecOctrees[ 0 ].insert( arrPoints[ i ] );
+  d7cA::Octree<d7cA::Point, double, void, true>  octreeMultiset;
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    octreeMultiset.insert( arrPoints[ i ] );
+  vecOctrees.push_back( d7cA::Octree<d7cA::Point, double>() );
+  vecOctrees[ 1 ].init( arrPoints, numPoints, d7cA::comparePoints<double> );
+
+  // move construction and move assignment leave the source empty:
+  d7cA::Octree<d7cA::Point, double>  octree( std::move( vecOctrees[ 1 ] ) );
+  BOOST_CHECK_EQUAL( octree.getNumElements(), numPoints );
+  BOOST_CHECK_EQUAL( vecOctrees[ 1 ].getNumElements(), 0 );
+  BOOST_CHECK( vecOctrees[ 1 ].begin() == vecOctrees[ 1 ].end() );
+  vecOctrees[ 1 ]  =  std::move( octree );
+  BOOST_CHECK_EQUAL( vecOctrees[ 1 ].getNumElements(), numPoints );
+  BOOST_CHECK_EQUAL( octree.getNumElements(), 0 );
+
+  const unsigned long  numInserted  =  vecOctrees[ 0 ].getNumElements();
+  swap( vecOctrees[ 0 ], vecOctrees[ 1 ] );
+  BOOST_CHECK_EQUAL( vecOctrees[ 0 ].getNumElements(), numPoints );
+  BOOST_CHECK_EQUAL( vecOctrees[ 1 ].getNumElements(), numInserted );
+
+  for ( std::size_t iTree = 0; iTree < vecOctrees.size(); ++iTree )
+    checkClone( vecOctrees[ iTree ], arrPoints, numPoints );
+  checkClone( octreeMultiset, arrPoints, numPoints );
+
+  delete [] arrPoints;
+  arrPoints  =  nullptr;
+}
+
+
+// two trees of the mode M grown by insert() are merged into one
+// holding all their elements ( testOctree8 ):
+template<bool  M>
+static
+void
+checkMerge( const d7cA::Point<double> * const  arrPoints, const std::size_t  numPoints1, const std::size_t  numPoints )
+{
+  d7cA::Octree<d7cA::Point, double, void, M>  octree1;
+  d7cA::Octree<d7cA::Point, double, void, M>  octree2;
+  for ( std::size_t i = 0; i < numPoints; ++i )
+  {
+    if ( numPoints1 > i )
+      octree1.insert( arrPoints[ i ] );
+    else
+      octree2.insert( arrPoints[ i ] );
+  }
+  const unsigned long  numElements  =  octree1.getNumElements() + octree2.getNumElements();
+
+  octree1.merge( std::move( octree2 ) );
+  BOOST_CHECK_EQUAL( octree1.getNumElements(), numElements );
+  BOOST_CHECK_EQUAL( octree2.getNumElements(), 0 );
+  BOOST_CHECK_EQUAL( octree2.getNumNodes(), 0 );
+  BOOST_CHECK( octree2.begin() == octree2.end() );
+
+  std::size_t  numNodes  =  0;
+  unsigned long  numCounted  =  0;
+  for ( const d7cA::OctreeObj<d7cA::Point, double, void, M>&  obj : octree1 )
+  {
+    numCounted  +=  obj.count;
+    ++numNodes;
+  }
+  BOOST_CHECK_EQUAL( numNodes, octree1.getNumNodes() );
+  BOOST_CHECK_EQUAL( numCounted, numElements );
+}
+
+
+BOOST_AUTO_TEST_CASE( testOctree8 )
+{
+  std::random_device  rd;
+  std::mt19937        gen( rd() );
+  std::uniform_int_distribution<>   dist( -4, +4 );
+  constexpr std::size_t  numPoints1  =  700;
+  constexpr std::size_t  numPoints2  =  500;
+  constexpr std::size_t  numPoints  =  numPoints1 + numPoints2;
+  d7cA::Point<double>  * arrPoints  =  new d7cA::Point<double> [ numPoints ];
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    arrPoints[ i ]  =  d7cA::Point<double>( dist( gen ), dist( gen ), dist( gen ), dist( gen ) );
+
+  checkMerge<false>( arrPoints, numPoints1, numPoints );
+  checkMerge<true>( arrPoints, numPoints1, numPoints );
+
+  // the trees built by init() are merged into a tree that finds each element:
+  std::sort( arrPoints, arrPoints + numPoints, d7cA::comparePoints<double> );
+  d7cA::Point<double>  * arrPoints1  =  new d7cA::Point<double> [ numPoints ];
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    arrPoints1[ i ]  =  arrPoints[ i ];
+  std::shuffle( arrPoints1, arrPoints1 + numPoints, gen );
+  d7cA::Octree<d7cA::Point, double>  octree1;
+  octree1.init( arrPoints1, numPoints1, d7cA::comparePoints<double> );
+  d7cA::Octree<d7cA::Point, double>  octree2;
+  octree2.init( arrPoints1 + numPoints1, numPoints2, d7cA::comparePoints<double> );
+  octree1.merge( std::move( octree2 ) );
+  BOOST_CHECK_EQUAL( octree1.getNumElements(), numPoints );
+
+  std::size_t  iPoint  =  0;
+  for ( const d7cA::OctreeObj<d7cA::Point, double>&  obj : octree1 )
+  {
+    if ( numPoints > iPoint )
+      BOOST_CHECK( arrPoints[ iPoint ] == obj.info );
+    ++iPoint;
+  }
+  BOOST_CHECK_EQUAL( iPoint, numPoints );
+  BOOST_CHECK_EQUAL( iPoint, octree1.getNumNodes() );
+
+  for ( std::size_t i = 0; i < numPoints; ++i )
+  {
+    std::size_t  numOperations  =  0;
+    const d7cA::OctreeObj<d7cA::Point, double> * const  result  =  octree1.find( arrPoints[ i ], numOperations );
+    BOOST_CHECK( nullptr != result );
+  }
+
+  // in the multiset mode the equal elements of both trees are merged:
+  d7cA::Octree<d7cA::Point, double, void, true>  octree3;
+  octree3.init( arrPoints1, numPoints, d7cA::comparePoints<double> );
+  d7cA::Octree<d7cA::Point, double, void, true>  octree4;
+  octree4.init( arrPoints1, numPoints, d7cA::comparePoints<double> );
+  const std::size_t  numNodes3  =  octree3.getNumNodes();
+  octree3.merge( std::move( octree4 ) );
+  BOOST_CHECK_EQUAL( octree3.getNumNodes(), numNodes3 );
+  BOOST_CHECK_EQUAL( octree3.getNumElements(), 2 * numPoints );
+
+  delete [] arrPoints1;
+  arrPoints1  =  nullptr;
+  delete [] arrPoints;
+  arrPoints  =  nullptr;
+}
+
+
+BOOST_AUTO_TEST_CASE( testOctree9 )
+{
+  std::random_device  rd;
+  std::mt19937        gen( rd() );
+  std::uniform_int_distribution<>   dist( -4, +4 );
+  constexpr std::size_t  numPoints  =  1000;
+  d7cA::Point<double>  * arrPoints  =  new d7cA::Point<double> [ numPoints ];
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    arrPoints[ i ]  =  d7cA::Point<double>( dist( gen ), dist( gen ), dist( gen ), dist( gen ) );
+
+  for ( int  pivot = -5; pivot <= +5; ++pivot )
+  {
+    d7cA::Octree<d7cA::Point, double>  octree;
+    octree.init( arrPoints, numPoints, d7cA::comparePoints<double> );
+    // the nodes of the clone share an arena, which must survive both halves:
+    d7cA::Octree<d7cA::Point, double>  octreeLower  =  octree.clone();
+    d7cA::Octree<d7cA::Point, double>  octreeUpper  =  octreeLower.split( pivot );
+    BOOST_CHECK_EQUAL( octreeLower.getNumElements() + octreeUpper.getNumElements(), numPoints );
+    BOOST_CHECK_EQUAL( octreeLower.getNumNodes() + octreeUpper.getNumNodes(), numPoints );
+
+    // the elements keep their order, the lower half precedes the upper one:
+    std::size_t  iPoint  =  0;
+    for ( const d7cA::OctreeObj<d7cA::Point, double>&  obj : octreeLower )
+    {
+      BOOST_CHECK( pivot > obj.info.x1() );
+      BOOST_CHECK( arrPoints[ iPoint ] == obj.info );
+      ++iPoint;
+    }
+    BOOST_CHECK_EQUAL( iPoint, octreeLower.getNumNodes() );
+    for ( const d7cA::OctreeObj<d7cA::Point, double>&  obj : octreeUpper )
+    {
+      BOOST_CHECK( pivot <= obj.info.x1() );
+      BOOST_CHECK( arrPoints[ iPoint ] == obj.info );
+      ++iPoint;
+    }
+    BOOST_CHECK_EQUAL( iPoint, numPoints );
+
+    for ( std::size_t i = 0; i < numPoints; ++i )
+    {
+      std::size_t  numOperations  =  0;
+      const d7cA::Octree<d7cA::Point, double>&  half  =  ( pivot > arrPoints[ i ].x1() ) ? octreeLower : octreeUpper;
+      BOOST_CHECK( nullptr != half.find( arrPoints[ i ], numOperations ) );
+    }
+
+    // the halves are merged back into the original tree:
+    octreeLower.merge( std::move( octreeUpper ) );
+    BOOST_CHECK_EQUAL( octreeLower.getNumNodes(), octree.getNumNodes() );
+    BOOST_CHECK( std::equal( octree.begin(), octree.end(), octreeLower.begin(),
+                             [] ( const d7cA::OctreeObj<d7cA::Point, double>&  a,
+                                  const d7cA::OctreeObj<d7cA::Point, double>&  b ) { return  a.info == b.info; } ) );
+  }
+
+  delete [] arrPoints;
+  arrPoints  =  nullptr;
+}
+
+
+BOOST_AUTO_TEST_CASE( testOctree10 )
+{
+  std::random_device  rd;
+  std::mt19937        gen( rd() );
+  std::uniform_real_distribution<>  dist( -10., +10. );
+  constexpr std::size_t  numPoints  =  2000;
+  d7cA::Point<double>  * arrPoints  =  new d7cA::Point<double> [ numPoints ];
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    arrPoints[ i ]  =  d7cA::Point<double>( dist( gen ), dist( gen ), dist( gen ), dist( gen ) );
+  d7cA::Octree<d7cA::Point, double>  octree;
+  octree.init( arrPoints, numPoints, d7cA::comparePoints<double> );
+
+  BOOST_CHECK( std::is_empty<d7cA::NoQueryStats>::value );
+
+  for ( const double  tolerance : { 0., 1., 3. } )
+  {
+    d7cA::QueryStats  statsTotal;
+    std::size_t  numOperationsTotal  =  0;
+    for ( std::size_t i = 0; i < numPoints; i += 10 )
+    {
+      const d7cA::Point<double>  p( arrPoints[ i ].x1() + 0.5, arrPoints[ i ].x2(), arrPoints[ i ].x3(), arrPoints[ i ].x4() );
+      std::size_t  numOperations  =  0;
+      const d7cA::OctreeObj<d7cA::Point, double> * const  result  =  octree.find( p, numOperations, tolerance );
+      d7cA::QueryStats  stats;
+      BOOST_CHECK( result == octree.find( p, stats, tolerance ) );
+      d7cA::NoQueryStats  noStats;
+      BOOST_CHECK( result == octree.find( p, noStats, tolerance ) );
+
+      // the hops of all the directions add up to the legacy counter:
+      BOOST_CHECK_EQUAL( stats.getNumHops(), numOperations );
+      BOOST_CHECK_EQUAL( stats.numNodesTouched, stats.getNumHops() + stats.numCalls );
+      BOOST_CHECK( 1 <= stats.numCalls );
+      BOOST_CHECK( 1 <= stats.maxDepth );
+      BOOST_CHECK( stats.maxDepth <= stats.numCalls );
+      BOOST_CHECK_EQUAL( stats.depth, 0 );
+      BOOST_CHECK( 1 <= stats.numPredicates );
+
+      octree.find( p, statsTotal, tolerance );
+      numOperationsTotal  +=  numOperations;
+    }
+    BOOST_CHECK_EQUAL( statsTotal.getNumHops(), numOperationsTotal );
+  }
+
+  delete [] arrPoints;
+  arrPoints  =  nullptr;
+}
+
+
+BOOST_AUTO_TEST_CASE( testOctree11 )
+{
+  const d7cA::Octree<d7cA::Point, double>  octreeEmpty;
+  const d7cA::OctreeStats  statsEmpty  =  octreeEmpty.stats();
+  BOOST_CHECK_EQUAL( statsEmpty.numNodes, 0 );
+  BOOST_CHECK_EQUAL( statsEmpty.numChains[ 0 ], 0 );
+
+  std::random_device  rd;
+  std::mt19937        gen( rd() );
+  std::uniform_int_distribution<>   dist( -4, +4 );
+  constexpr std::size_t  numPoints  =  1500;
+  d7cA::Point<double>  * arrPoints  =  new d7cA::Point<double> [ numPoints ];
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    arrPoints[ i ]  =  d7cA::Point<double>( dist( gen ), dist( gen ), dist( gen ), dist( gen ) );
+  d7cA::Octree<d7cA::Point, double>  octree;
+  octree.init( arrPoints, numPoints, d7cA::comparePoints<double> );
+
+  std::size_t  numX1  =  1;
+  for ( std::size_t i = 1; i < numPoints; ++i )
+    if ( arrPoints[ i - 1 ].x1() != arrPoints[ i ].x1() )
+      ++numX1;
+
+  const d7cA::OctreeStats  stats  =  octree.stats();
+  BOOST_CHECK_EQUAL( stats.numNodes, numPoints );
+  BOOST_CHECK_EQUAL( stats.numElements, numPoints );
+  BOOST_CHECK( stats.numBytes >= numPoints * sizeof( d7cA::OctreeObj<d7cA::Point, double> ) );
+  // a single North-South chain, the root is in its middle:
+  BOOST_CHECK_EQUAL( stats.numChains[ 0 ], 1 );
+  BOOST_CHECK_EQUAL( stats.maxChainLength[ 0 ], numX1 );
+  BOOST_CHECK_EQUAL( stats.distanceToSouth + stats.distanceToNorth + 1, numX1 );
+  BOOST_CHECK( 1 >= stats.distanceToNorth - stats.distanceToSouth );
+  BOOST_CHECK( 0.9 < stats.balance );
+  BOOST_CHECK( stats.maxDepth >= stats.distanceToSouth );
+  BOOST_CHECK( stats.meanDepth <= stats.maxDepth );
+  for ( unsigned short  iPair = 0; iPair < 4; ++iPair )
+  {
+    std::size_t  numInBins  =  0;
+    for ( unsigned short  iBin = 0; iBin < d7cA::OctreeStats::numBins; ++iBin )
+      numInBins  +=  stats.chainLengths[ iPair ][ iBin ];
+    BOOST_CHECK_EQUAL( numInBins, stats.numChains[ iPair ] );
+    BOOST_CHECK( stats.sumChainLength[ iPair ] <= numPoints );
+  }
+
+  // a clone is held by an arena:
+  const d7cA::Octree<d7cA::Point, double>  octreeClone  =  octree.clone();
+  const d7cA::OctreeStats  statsClone  =  octreeClone.stats();
+  BOOST_CHECK_EQUAL( statsClone.maxChainLength[ 0 ], stats.maxChainLength[ 0 ] );
+  BOOST_CHECK_EQUAL( statsClone.maxDepth, stats.maxDepth );
+  BOOST_CHECK( statsClone.numBytes >= numPoints * sizeof( d7cA::OctreeObj<d7cA::Point, double> ) );
+
+  delete [] arrPoints;
+  arrPoints  =  nullptr;
+}
+
+
+BOOST_AUTO_TEST_CASE( testOctree12 )
+{
+  typedef  d7cA::OctreeAccess<TraversalTest>  Access;
+  constexpr std::size_t  numPoints  =  100;
+
+  // a single chain of the pair 'iPair' ( 1 - W/E, 2 - NW/SE, 3 - SW/NE ):
+  // the points differ in the coordinate 'x(iPair+1)' only:
+  for ( unsigned short  iPair = 1; iPair < 4; ++iPair )
+  {
+    std::vector<d7cA::Point<double> >  vecPoints;
+    for ( std::size_t i = 0; i < numPoints; ++i )
+    {
+      double  x[ 4 ]  =  { 0, 0, 0, 0 };
+      x[ iPair ]  =  static_cast<double>( i );
+      vecPoints.push_back( d7cA::Point<double>( x[ 0 ], x[ 1 ], x[ 2 ], x[ 3 ] ) );
+    }
+    d7cA::Octree<d7cA::Point, double>  octree;
+    octree.init( vecPoints.data(), numPoints, d7cA::comparePoints<double> );
+    BOOST_CHECK_EQUAL( octree.stats().maxChainLength[ iPair ], numPoints );
+
+    double  x[ 4 ]  =  { 0, 0, 0, 0 };
+    x[ iPair ]  =  37;
+    const d7cA::Point<double>  target( x[ 0 ], x[ 1 ], x[ 2 ], x[ 3 ] );
+    // a query off the chain: within the tolerance of every node along 'iPair',
+    // out of the tolerance of all of them along x1:
+    x[ 0 ]  =  2 * numPoints;
+    const d7cA::Point<double>  miss( x[ 0 ], x[ 1 ], x[ 2 ], x[ 3 ] );
+
+    d7cA::QueryStats  stats;
+    const d7cA::OctreeObj<d7cA::Point, double>  *pFound  =  nullptr;
+    d7cA::QueryStats  statsMiss;
+    if ( 1 == iPair )
+    {
+      pFound  =  Access::moveAlongWestEast( octree, target, 0, stats );
+      Access::moveAlongWestEast( octree, miss, numPoints, statsMiss );
+    }
+    if ( 2 == iPair )
+    {
+      pFound  =  Access::moveAlongNWSE( octree, target, 0, stats );
+      Access::moveAlongNWSE( octree, miss, numPoints, statsMiss );
+    }
+    if ( 3 == iPair )
+    {
+      pFound  =  Access::moveAlongSWNE( octree, target, 0, stats );
+      Access::moveAlongSWNE( octree, miss, numPoints, statsMiss );
+    }
+    BOOST_REQUIRE( nullptr != pFound );
+    BOOST_CHECK( target == pFound->info );
+    // the routines hop along their own chains only:
+    BOOST_CHECK_EQUAL( stats.numHops[ iPair ], stats.getNumHops() );
+    BOOST_CHECK_EQUAL( statsMiss.numHops[ iPair ], statsMiss.getNumHops() );
+    // a miss within the tolerance along the chain visits all of its nodes:
+    BOOST_CHECK( numPoints - 1 <= statsMiss.getNumHops() );
+
+    // the routines searching the levels below a node within the tolerance
+    // along the upper levels find the same node:
+    if ( 2 == iPair )
+    {
+      d7cA::QueryStats  statsIn;
+      pFound  =  Access::findInWestEastNWSESWNE( octree, target, 0, statsIn );
+      BOOST_REQUIRE( nullptr != pFound );
+      BOOST_CHECK( target == pFound->info );
+    }
+    if ( 3 == iPair )
+    {
+      d7cA::QueryStats  statsIn;
+      pFound  =  Access::findInNWSESWNE( octree, target, 0, statsIn );
+      BOOST_REQUIRE( nullptr != pFound );
+      BOOST_CHECK( target == pFound->info );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( testOctree13 )
+{
+  constexpr std::size_t  numPoints  =  1000;
+  const double  lo[ 4 ]  =  { -10, 0, 0, 5 };
+  const double  hi[ 4 ]  =  { 10, 1, 100, 5 };
+  std::mt19937  gen( 13 );
+  std::vector<d7cA::Point<double> >  vecPoints;
+  for ( std::size_t i = 0; i < numPoints; ++i )
+  {
+    double  x[ 4 ];
+    for ( unsigned short  k = 0; k < 4; ++k )
+      x[ k ]  =  std::uniform_real_distribution<>( lo[ k ], hi[ k ] )( gen );
+    vecPoints.push_back( d7cA::Point<double>( x[ 0 ], x[ 1 ], x[ 2 ], x[ 3 ] ) );
+  }
+
+  d7cA::QuantizedOctree<d7cA::Point, double>  octree( lo, hi );
+  octree.init( vecPoints.data(), numPoints, d7cA::comparePoints<std::int16_t> );
+  const double  resolution  =  octree.getResolution();
+  BOOST_CHECK( resolution > 0 && resolution < 0.01 );
+  // the points are left untouched ( not sorted ) by init():
+  BOOST_CHECK( false == std::is_sorted( vecPoints.begin(), vecPoints.end(), d7cA::comparePoints<double> ) );
+
+  // dequantize() restores a coordinate within half of the resolution:
+  for ( const d7cA::Point<double>&  p : vecPoints )
+  {
+    const d7cA::Point<double>  q  =  octree.dequantize( octree.quantize( p ) );
+    BOOST_CHECK( std::abs( q.x1() - p.x1() ) <= resolution / 2 * 1.0001 );
+    BOOST_CHECK( std::abs( q.x2() - p.x2() ) <= resolution / 2 * 1.0001 );
+    BOOST_CHECK( std::abs( q.x3() - p.x3() ) <= resolution / 2 * 1.0001 );
+    BOOST_CHECK( std::abs( q.x4() - p.x4() ) <= resolution / 2 * 1.0001 );
+  }
+
+  // a query within the tolerance of a stored point is never missed,
+  // and the point found is at most 2 resolutions beyond the tolerance:
+  const double  tolerance  =  0.01;
+  std::uniform_real_distribution<>  distShift( -tolerance, tolerance );
+  for ( const d7cA::Point<double>&  p : vecPoints )
+  {
+    const d7cA::Point<double>  query( p.x1() + distShift( gen ), p.x2(), p.x3() + distShift( gen ), p.x4() );
+    d7cA::NoQueryStats  stats;
+    const d7cA::OctreeObj<d7cA::Point, std::int16_t>  *pFound  =  octree.find( query, stats, tolerance );
+    BOOST_REQUIRE( nullptr != pFound );
+    const d7cA::Point<double>  q  =  octree.dequantize( pFound->info );
+    BOOST_CHECK( std::abs( q.x1() - query.x1() ) <= tolerance + 2 * resolution );
+    BOOST_CHECK( std::abs( q.x2() - query.x2() ) <= tolerance + 2 * resolution );
+    BOOST_CHECK( std::abs( q.x3() - query.x3() ) <= tolerance + 2 * resolution );
+    BOOST_CHECK( std::abs( q.x4() - query.x4() ) <= tolerance + 2 * resolution );
+  }
+
+  // a point outside of the ranges is clamped to them:
+  const d7cA::Point<double>  q  =  octree.dequantize( octree.quantize( d7cA::Point<double>( 1000, -1000, 50, 5 ) ) );
+  BOOST_CHECK( std::abs( q.x1() - hi[ 0 ] ) <= resolution / 2 * 1.0001 );
+  BOOST_CHECK( std::abs( q.x2() - lo[ 1 ] ) <= resolution / 2 * 1.0001 );
+  // but a query is not, it has no match farther than the tolerance from the ranges:
+  d7cA::NoQueryStats  stats;
+  BOOST_CHECK( nullptr == octree.find( d7cA::Point<double>( hi[ 0 ] + 1, 0, 50, 5 ), stats, 0.5 ) );
+
+  // the nodes of 16 bit coordinates are smaller:
+  BOOST_CHECK( sizeof( d7cA::OctreeObj<d7cA::Point, std::int16_t> ) < sizeof( d7cA::OctreeObj<d7cA::Point, double> ) );
+  BOOST_CHECK_EQUAL( octree.getOctree().getNumNodes(), numPoints );
+}
+
+// the trees of the mode M grown by the same inserts of the points
+// and of the packed points have the same shape and hold the same elements
+// in the same order ( testOctree14 ):
+template<bool  M>
+static
+void
+checkPackedShape( const std::vector<d7cA::Point<std::int16_t> >&        vecPoints,
+                  const std::vector<d7cA::PackedPoint<std::int16_t> >&  vecPacked
+                )
+{
+  const std::size_t  numPoints  =  vecPoints.size();
+  d7cA::Octree<d7cA::Point, std::int16_t, void, M>        octree;
+  d7cA::Octree<d7cA::PackedPoint, std::int16_t, void, M>  octreePacked;
+  for ( std::size_t i = 0; i < numPoints; ++i )
+  {
+    octree.insert( vecPoints[ i ] );
+    octreePacked.insert( vecPacked[ i ] );
+  }
+  BOOST_CHECK_EQUAL( octree.getNumNodes(), octreePacked.getNumNodes() );
+  BOOST_CHECK_EQUAL( octree.getNumElements(), octreePacked.getNumElements() );
+  const d7cA::OctreeStats  stats  =  octree.stats();
+  const d7cA::OctreeStats  statsPacked  =  octreePacked.stats();
+  for ( unsigned short  iPair = 0; iPair < 4; ++iPair )
+  {
+    BOOST_CHECK_EQUAL( stats.maxChainLength[ iPair ], statsPacked.maxChainLength[ iPair ] );
+    BOOST_CHECK_EQUAL( stats.sumChainLength[ iPair ], statsPacked.sumChainLength[ iPair ] );
+  }
+  typename d7cA::Octree<d7cA::PackedPoint, std::int16_t, void, M>::const_iterator  itPacked  =  octreePacked.begin();
+  for ( const d7cA::OctreeObj<d7cA::Point, std::int16_t, void, M>&  obj : octree )
+  {
+    BOOST_REQUIRE( itPacked != octreePacked.end() );
+    BOOST_CHECK( obj.info.x1() == itPacked->info.x1()
+              && obj.info.x2() == itPacked->info.x2()
+              && obj.info.x3() == itPacked->info.x3()
+              && obj.info.x4() == itPacked->info.x4() );
+    BOOST_CHECK_EQUAL( obj.count, itPacked->count );
+    ++itPacked;
+  }
+  BOOST_CHECK( itPacked == octreePacked.end() );
+}
+
+BOOST_AUTO_TEST_CASE( testOctree14 )
+{
+  // the packed coordinates are restored exactly, the extremes included:
+  const d7cA::PackedPoint<std::int16_t>  extremes( -32768, 32767, 0, -1 );
+  BOOST_CHECK_EQUAL( extremes.x1(), -32768 );
+  BOOST_CHECK_EQUAL( extremes.x2(), 32767 );
+  BOOST_CHECK_EQUAL( extremes.x3(), 0 );
+  BOOST_CHECK_EQUAL( extremes.x4(), -1 );
+  BOOST_CHECK_EQUAL( sizeof( d7cA::PackedPoint<std::int16_t> ), 8 );
+
+  constexpr std::size_t  numPoints  =  2000;
+  std::mt19937  gen( 14 );
+  // few distinct values, so that the points share prefixes of their coordinates:
+  std::uniform_int_distribution<int>  dist( -3, 3 );
+  std::vector<d7cA::Point<std::int16_t> >        vecPoints;
+  std::vector<d7cA::PackedPoint<std::int16_t> >  vecPacked;
+  for ( std::size_t i = 0; i < numPoints; ++i )
+  {
+    const std::int16_t  x[ 4 ]  =  { static_cast<std::int16_t>( dist( gen ) * 10000 ), static_cast<std::int16_t>( dist( gen ) ),
+                                     static_cast<std::int16_t>( dist( gen ) ), static_cast<std::int16_t>( dist( gen ) ) };
+    vecPoints.push_back( d7cA::Point<std::int16_t>( x[ 0 ], x[ 1 ], x[ 2 ], x[ 3 ] ) );
+    vecPacked.push_back( d7cA::PackedPoint<std::int16_t>( x[ 0 ], x[ 1 ], x[ 2 ], x[ 3 ] ) );
+  }
+  // the order of the keys is the order of the points:
+  for ( std::size_t i = 1; i < numPoints; ++i )
+  {
+    BOOST_CHECK_EQUAL( d7cA::comparePackedPoints( vecPacked[ i - 1 ], vecPacked[ i ] ),
+                       d7cA::comparePoints( vecPoints[ i - 1 ], vecPoints[ i ] ) );
+    BOOST_CHECK_EQUAL( vecPacked[ i - 1 ] == vecPacked[ i ], vecPoints[ i - 1 ] == vecPoints[ i ] );
+  }
+
+  checkPackedShape<false>( vecPoints, vecPacked );
+  checkPackedShape<true>( vecPoints, vecPacked );
+
+  // a tree initialized from the packed points finds every one of them:
+  d7cA::Octree<d7cA::PackedPoint, std::int16_t>  octreePacked;
+  std::vector<d7cA::PackedPoint<std::int16_t> >  vecInit( vecPacked );
+  octreePacked.init( vecInit.data(), numPoints, d7cA::comparePackedPoints<std::int16_t> );
+  for ( const d7cA::PackedPoint<std::int16_t>&  p : vecPacked )
+  {
+    d7cA::NoQueryStats  stats;
+    const d7cA::OctreeObj<d7cA::PackedPoint, std::int16_t>  *pFound  =  octreePacked.find( p, stats );
+    BOOST_REQUIRE( nullptr != pFound );
+    BOOST_CHECK( p == pFound->info );
+  }
+
+  // the exact find() compares the keys, it takes the same walk
+  // as over the plain points and misses the same queries:
+  d7cA::Octree<d7cA::Point, std::int16_t>  octree;
+  std::vector<d7cA::Point<std::int16_t> >  vecPlain( vecPoints );
+  octree.init( vecPlain.data(), numPoints, d7cA::comparePoints<std::int16_t> );
+  for ( std::size_t i = 0; i < numPoints; ++i )
+  {
+    const std::int16_t  x[ 4 ]  =  { static_cast<std::int16_t>( dist( gen ) * 10000 + dist( gen ) % 2 ), static_cast<std::int16_t>( dist( gen ) ),
+                                     static_cast<std::int16_t>( dist( gen ) ), static_cast<std::int16_t>( 2 * dist( gen ) ) };
+    d7cA::QueryStats  stats;
+    d7cA::QueryStats  statsPacked;
+    const d7cA::OctreeObj<d7cA::Point, std::int16_t>  *pFound  =  octree.find( d7cA::Point<std::int16_t>( x[ 0 ], x[ 1 ], x[ 2 ], x[ 3 ] ), stats );
+    const d7cA::OctreeObj<d7cA::PackedPoint, std::int16_t>  *pFoundPacked  =  octreePacked.find( d7cA::PackedPoint<std::int16_t>( x[ 0 ], x[ 1 ], x[ 2 ], x[ 3 ] ), statsPacked );
+    BOOST_CHECK_EQUAL( nullptr == pFound, nullptr == pFoundPacked );
+    BOOST_CHECK_EQUAL( stats.getNumHops(), statsPacked.getNumHops() );
+    BOOST_CHECK_EQUAL( stats.numPredicates, statsPacked.numPredicates );
+  }
+}
+
+BOOST_AUTO_TEST_CASE( testOctree15 )
+{
+  constexpr std::size_t  numPoints  =  3000;
+  std::mt19937  gen( 15 );
+  std::uniform_int_distribution<int>  dist( 0, 20 );
+  std::vector<d7cA::Point<double> >  vecPoints;
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    vecPoints.push_back( d7cA::Point<double>( dist( gen ), dist( gen ), dist( gen ), dist( gen ) ) );
+
+  const d7cA::OctreeLayout  layouts[ 2 ]  =  { d7cA::OctreeLayout::depthFirst, d7cA::OctreeLayout::chains };
+  for ( const d7cA::OctreeLayout  layout : layouts )
+  {
+    d7cA::Octree<d7cA::Point, double, void, true>  octree;
+    d7cA::Octree<d7cA::Point, double, void, true>  octreeRelaid;
+    for ( const d7cA::Point<double>&  p : vecPoints )
+    {
+      octree.insert( p );
+      octreeRelaid.insert( p );
+    }
+    octreeRelaid.relayout( layout );
+
+    // the shape of the tree and its elements are kept:
+    BOOST_CHECK_EQUAL( octree.getNumNodes(), octreeRelaid.getNumNodes() );
+    BOOST_CHECK_EQUAL( octree.getNumElements(), octreeRelaid.getNumElements() );
+    const d7cA::OctreeStats  stats  =  octree.stats();
+    const d7cA::OctreeStats  statsRelaid  =  octreeRelaid.stats();
+    BOOST_CHECK_EQUAL( stats.maxDepth, statsRelaid.maxDepth );
+    BOOST_CHECK_EQUAL( stats.distanceToSouth, statsRelaid.distanceToSouth );
+    for ( unsigned short  iPair = 0; iPair < 4; ++iPair )
+      BOOST_CHECK_EQUAL( stats.sumChainLength[ iPair ], statsRelaid.sumChainLength[ iPair ] );
+    d7cA::Octree<d7cA::Point, double, void, true>::const_iterator  itRelaid  =  octreeRelaid.begin();
+    for ( const d7cA::OctreeObj<d7cA::Point, double, void, true>&  obj : octree )
+    {
+      BOOST_REQUIRE( itRelaid != octreeRelaid.end() );
+      BOOST_CHECK( obj.info == itRelaid->info );
+      BOOST_CHECK_EQUAL( obj.count, itRelaid->count );
+      ++itRelaid;
+    }
+
+    // and so are the results of the queries, node for node:
+    for ( const d7cA::Point<double>&  p : vecPoints )
+    {
+      d7cA::QueryStats  statsQuery;
+      d7cA::QueryStats  statsQueryRelaid;
+      const d7cA::OctreeObj<d7cA::Point, double, void, true>  *pFound  =  octree.find( p, statsQuery, 1. );
+      const d7cA::OctreeObj<d7cA::Point, double, void, true>  *pFoundRelaid  =  octreeRelaid.find( p, statsQueryRelaid, 1. );
+      BOOST_REQUIRE( ( nullptr == pFound ) == ( nullptr == pFoundRelaid ) );
+      if ( nullptr != pFound )
+        BOOST_CHECK( pFound->info == pFoundRelaid->info );
+      BOOST_CHECK_EQUAL( statsQuery.numNodesTouched, statsQueryRelaid.numNodesTouched );
+    }
+
+    // the relaid tree still accepts new elements:
+    octreeRelaid.insert( d7cA::Point<double>( 100, 100, 100, 100 ) );
+    BOOST_CHECK_EQUAL( octreeRelaid.getNumNodes(), octree.getNumNodes() + 1 );
+  }
+}
+
+BOOST_AUTO_TEST_CASE( testOctree16 )
+{
+  constexpr std::size_t  numPoints  =  2000;
+  std::mt19937  gen( 16 );
+  std::uniform_real_distribution<double>  dist( 0, 100 );
+  std::vector<d7cA::Point<double> >  vecPoints;
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    vecPoints.push_back( d7cA::Point<double>( dist( gen ), dist( gen ), dist( gen ), dist( gen ) ) );
+
+  // exact hits, near misses and a few wide or negative tolerances:
+  std::vector<d7cA::Point<double> >  vecQueries;
+  std::vector<double>  vecTolerances;
+  for ( std::size_t i = 0; i < numPoints; ++i )
+  {
+    const d7cA::Point<double>&  p  =  vecPoints[ i ];
+    vecQueries.push_back( ( 0 == i % 2 ) ? p : d7cA::Point<double>( p.x1() + 0.01, p.x2(), p.x3(), p.x4() ) );
+    vecTolerances.push_back( ( 0 == i % 7 ) ? 5. : ( ( 0 == i % 11 ) ? -1. : ( ( 0 == i % 3 ) ? 0.02 : 0. ) ) );
+  }
+
+  d7cA::Octree<d7cA::Point, double>  octreeInit;
+  std::vector<d7cA::Point<double> >  vecSorted( vecPoints );
+  octreeInit.init( vecSorted.data(), numPoints, d7cA::comparePoints<double> );
+  d7cA::Octree<d7cA::Point, double>  octreeInsert;
+  for ( const d7cA::Point<double>&  p : vecPoints )
+    octreeInsert.insert( p );
+
+  const d7cA::Octree<d7cA::Point, double> * const  trees[ 2 ]  =  { &octreeInit, &octreeInsert };
+  for ( const d7cA::Octree<d7cA::Point, double> * const  pOctree : trees )
+  {
+    std::vector<d7cA::OctreeObj<d7cA::Point, double> *>  vecExpected;
+    for ( std::size_t i = 0; i < numPoints; ++i )
+    {
+      d7cA::NoQueryStats  stats;
+      vecExpected.push_back( pOctree->find( vecQueries[ i ], stats, vecTolerances[ i ] ) );
+    }
+    // the same nodes whatever the number of queries in flight:
+    std::vector<d7cA::OctreeObj<d7cA::Point, double> *>  vecResults( numPoints, nullptr );
+    pOctree->findBatch<1>( vecQueries.data(), vecTolerances.data(), numPoints, vecResults.data() );
+    BOOST_CHECK( vecExpected == vecResults );
+    std::fill( vecResults.begin(), vecResults.end(), nullptr );
+    pOctree->findBatch<3>( vecQueries.data(), vecTolerances.data(), numPoints, vecResults.data() );
+    BOOST_CHECK( vecExpected == vecResults );
+    std::fill( vecResults.begin(), vecResults.end(), nullptr );
+    pOctree->findBatch( vecQueries.data(), vecTolerances.data(), numPoints, vecResults.data() );
+    BOOST_CHECK( vecExpected == vecResults );
+    // fewer queries than slots:
+    std::fill( vecResults.begin(), vecResults.end(), nullptr );
+    pOctree->findBatch<64>( vecQueries.data(), vecTolerances.data(), 5, vecResults.data() );
+    BOOST_CHECK( std::equal( vecResults.begin(), vecResults.begin() + 5, vecExpected.begin() ) );
+  }
+
+  // an empty tree returns its null root:
+  d7cA::Octree<d7cA::Point, double>  octreeEmpty;
+  d7cA::OctreeObj<d7cA::Point, double>  node;
+  d7cA::OctreeObj<d7cA::Point, double>  *pResult  =  &node;
+  octreeEmpty.findBatch( vecQueries.data(), vecTolerances.data(), 1, &pResult );
+  BOOST_CHECK( nullptr == pResult );
+}
+
+BOOST_AUTO_TEST_CASE( testOctree17 )
+{
+  // the differences of integral coordinates do not overflow:
+  constexpr int  minInt  =  std::numeric_limits<int>::min();
+  constexpr int  maxInt  =  std::numeric_limits<int>::max();
+  BOOST_CHECK( false == d7cA::ToleranceCheck<int>::isWithin( minInt, maxInt, maxInt ) );
+  BOOST_CHECK( false == d7cA::ToleranceCheck<int>::isWithin( -1, maxInt, maxInt ) );
+  BOOST_CHECK( true == d7cA::ToleranceCheck<int>::isWithin( 0, maxInt, maxInt ) );
+  BOOST_CHECK( true == d7cA::ToleranceCheck<int>::isWithin( minInt, minInt + 1, 1 ) );
+  BOOST_CHECK( true == d7cA::ToleranceCheck<std::int16_t>::isNegative( -1 ) );
+  BOOST_CHECK( false == d7cA::ToleranceCheck<unsigned>::isNegative( 0 ) );
+
+  const int  values[ 5 ]  =  { minInt, -1, 0, 1, maxInt };
+  d7cA::Point<int>  arrPoints[ 5 ];
+  for ( std::size_t i = 0; i < 5; ++i )
+    arrPoints[ i ]  =  d7cA::Point<int>( values[ i ], values[ i ], values[ i ], values[ i ] );
+  d7cA::Octree<d7cA::Point, int>  octree;
+  octree.init( arrPoints, 5, d7cA::comparePoints<int> );
+  for ( const int  v : values )
+  {
+    d7cA::NoQueryStats  stats;
+    const d7cA::OctreeObj<d7cA::Point, int> * const  pFound  =  octree.find( d7cA::Point<int>( v, v, v, v ), stats );
+    BOOST_REQUIRE( nullptr != pFound );
+    BOOST_CHECK_EQUAL( pFound->info.x1(), v );
+  }
+  d7cA::NoQueryStats  stats;
+  BOOST_CHECK( nullptr == octree.find( d7cA::Point<int>( minInt + 1, minInt, minInt, minInt ), stats ) );
+  const d7cA::OctreeObj<d7cA::Point, int> * const  pMin  =  octree.find( d7cA::Point<int>( minInt + 1, minInt, minInt, minInt ), stats, 1 );
+  BOOST_REQUIRE( nullptr != pMin );
+  BOOST_CHECK_EQUAL( pMin->info.x1(), minInt );
+  const d7cA::OctreeObj<d7cA::Point, int> * const  pMax  =  octree.find( d7cA::Point<int>( maxInt - 1, maxInt, maxInt, maxInt ), stats, 1 );
+  BOOST_REQUIRE( nullptr != pMax );
+  BOOST_CHECK_EQUAL( pMax->info.x1(), maxInt );
+  // any negative tolerance returns the root, whatever the coordinate type:
+  BOOST_CHECK( octree.find( arrPoints[ 0 ], stats, -1 ) == octree.find( arrPoints[ 2 ], stats, -5 ) );
+
+  const unsigned  uValues[ 3 ]  =  { 0, 1, std::numeric_limits<unsigned>::max() };
+  d7cA::Octree<d7cA::Point, unsigned>  octreeUnsigned;
+  for ( const unsigned  v : uValues )
+    octreeUnsigned.insert( d7cA::Point<unsigned>( v, v, v, v ) );
+  const d7cA::OctreeObj<d7cA::Point, unsigned> * const  pMaxUnsigned  =  octreeUnsigned.find( d7cA::Point<unsigned>( uValues[ 2 ] - 1, uValues[ 2 ], uValues[ 2 ], uValues[ 2 ] ), stats, 1u );
+  BOOST_REQUIRE( nullptr != pMaxUnsigned );
+  BOOST_CHECK_EQUAL( pMaxUnsigned->info.x1(), uValues[ 2 ] );
+  BOOST_CHECK( nullptr == octreeUnsigned.find( d7cA::Point<unsigned>( 2, 2, 2, 2 ), stats ) );
+
+  // the exact path finds every element of a tree built by init()
+  // and nothing off them, with fewer hops than a tiny tolerance:
+  constexpr std::size_t  numPoints  =  2000;
+  std::mt19937  gen( 17 );
+  std::uniform_int_distribution<int>  dist( 0, 30 );
+  std::vector<d7cA::Point<double> >  vecPoints;
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    vecPoints.push_back( d7cA::Point<double>( dist( gen ), dist( gen ), dist( gen ), dist( gen ) ) );
+  std::vector<d7cA::Point<double> >  vecSorted( vecPoints );
+  d7cA::Octree<d7cA::Point, double>  octreeDouble;
+  octreeDouble.init( vecSorted.data(), numPoints, d7cA::comparePoints<double> );
+  d7cA::QueryStats  statsExact;
+  d7cA::QueryStats  statsTolerance;
+  for ( const d7cA::Point<double>&  p : vecPoints )
+  {
+    const d7cA::OctreeObj<d7cA::Point, double> * const  pFound  =  octreeDouble.find( p, statsExact );
+    BOOST_REQUIRE( nullptr != pFound );
+    BOOST_CHECK( p == pFound->info );
+    BOOST_CHECK( nullptr != octreeDouble.find( p, statsTolerance, 1e-9 ) );
+    BOOST_CHECK( nullptr == octreeDouble.find( d7cA::Point<double>( p.x1() + 0.5, p.x2(), p.x3(), p.x4() ), stats ) );
+  }
+  BOOST_CHECK( statsExact.numHops[ 0 ] < statsTolerance.numHops[ 0 ] );
+}
+
+// the hash index of 'octree' finds every element stored
+// by a single probe, and nothing else ( testOctree18 ):
+template<bool  M>
+static
+void
+checkHashIndex( const d7cA::Octree<d7cA::Point, double, void, M>&  octree, const std::vector<d7cA::Point<double> >&  vecQueries )
+{
+  BOOST_REQUIRE( true == octree.hasHashIndex() );
+  std::vector<d7cA::Point<double> >  vecStored;
+  for ( const d7cA::OctreeObj<d7cA::Point, double, void, M>&  obj : octree )
+    vecStored.push_back( obj.info );
+  std::sort( vecStored.begin(), vecStored.end(), d7cA::comparePoints<double> );
+  for ( const d7cA::Point<double>&  p : vecQueries )
+  {
+    d7cA::QueryStats  stats;
+    const d7cA::OctreeObj<d7cA::Point, double, void, M> * const  pFound  =  octree.find( p, stats );
+    const bool  isStored  =  std::binary_search( vecStored.begin(), vecStored.end(), p, d7cA::comparePoints<double> );
+    BOOST_REQUIRE( isStored == ( nullptr != pFound ) );
+    if ( nullptr != pFound )
+      BOOST_CHECK( p == pFound->info );
+    BOOST_CHECK_EQUAL( stats.getNumHops(), 0u );
+  }
+}
+
+
+// the index built at once and the one kept up by insert() follow
+// the nodes of a tree of the mode M around ( testOctree18 ):
+template<bool  M>
+static
+void
+checkHashIndexUpkeep( const std::vector<d7cA::Point<double> >&  vecPoints, const std::vector<d7cA::Point<double> >&  vecQueries )
+{
+  d7cA::Octree<d7cA::Point, double, void, M>  octree;
+  d7cA::Octree<d7cA::Point, double, void, M>  octreeIndexed;
+  octreeIndexed.setHashIndex( true );
+  for ( const d7cA::Point<double>&  p : vecPoints )
+  {
+    octree.insert( p );
+    octreeIndexed.insert( p );
+  }
+  octree.setHashIndex( true );
+  checkHashIndex( octree, vecQueries );
+  checkHashIndex( octreeIndexed, vecQueries );
+  const d7cA::OctreeStats  stats  =  octree.stats();
+  BOOST_CHECK( 0 < stats.numIndexBytes );
+  BOOST_CHECK( stats.numIndexBytes < stats.numBytes );
+
+  // the index follows the nodes around:
+  octree.relayout();
+  checkHashIndex( octree, vecQueries );
+  d7cA::Octree<d7cA::Point, double, void, M>  upper  =  octree.split( 6 );
+  checkHashIndex( octree, vecQueries );
+  checkHashIndex( upper, vecQueries );
+  octree.merge( std::move( upper ) );
+  checkHashIndex( octree, vecQueries );
+  const d7cA::Octree<d7cA::Point, double, void, M>  moved( std::move( octree ) );
+  checkHashIndex( moved, vecQueries );
+
+  octreeIndexed.setHashIndex( false );
+  BOOST_CHECK( false == octreeIndexed.hasHashIndex() );
+  BOOST_CHECK_EQUAL( octreeIndexed.stats().numIndexBytes, 0u );
+}
+
+
+BOOST_AUTO_TEST_CASE( testOctree18 )
+{
+  constexpr std::size_t  numPoints  =  3000;
+  std::mt19937  gen( 18 );
+  std::uniform_int_distribution<int>  dist( 0, 12 );
+  std::vector<d7cA::Point<double> >  vecPoints;
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    vecPoints.push_back( d7cA::Point<double>( dist( gen ), dist( gen ), dist( gen ), dist( gen ) ) );
+
+  std::vector<d7cA::Point<double> >  vecQueries( vecPoints );
+  vecQueries.push_back( d7cA::Point<double>( 0.5, 0, 0, 0 ) );
+  vecQueries.push_back( d7cA::Point<double>( -0., 0, 0, 0 ) );
+
+  checkHashIndexUpkeep<false>( vecPoints, vecQueries );
+  checkHashIndexUpkeep<true>( vecPoints, vecQueries );
+
+  // findBatch() probes the index too:
+  d7cA::Octree<d7cA::Point, double>  octree;
+  std::vector<d7cA::Point<double> >  vecSorted( vecPoints );
+  octree.init( vecSorted.data(), numPoints, d7cA::comparePoints<double> );
+  octree.setHashIndex( true );
+  const std::vector<double>  vecTolerances( numPoints, 0. );
+  std::vector<d7cA::OctreeObj<d7cA::Point, double> *>  vecResults( numPoints, nullptr );
+  octree.findBatch( vecPoints.data(), vecTolerances.data(), numPoints, vecResults.data() );
+  for ( std::size_t i = 0; i < numPoints; ++i )
+  {
+    BOOST_REQUIRE( nullptr != vecResults[ i ] );
+    BOOST_CHECK( vecPoints[ i ] == vecResults[ i ]->info );
+  }
+}
+
+
+// compares countWithin() with a count over the iteration of the whole tree:
+template<bool  M>
+static
+void
+checkCountWithin( const d7cA::Octree<d7cA::Point, double, void, M>&  octree, const std::vector<d7cA::Point<double> >&  vecQueries )
+{
+  const double  tolerances[ 4 ]  =  { 0., 1., 2.5, 20. };
+  for ( const d7cA::Point<double>&  p : vecQueries )
+    for ( const double  tolerance : tolerances )
+    {
+      std::size_t  num  =  0;
+      for ( const d7cA::OctreeObj<d7cA::Point, double, void, M>&  obj : octree )
+        if ( tolerance >= std::abs( obj.info.x1() - p.x1() )
+          && tolerance >= std::abs( obj.info.x2() - p.x2() )
+          && tolerance >= std::abs( obj.info.x3() - p.x3() )
+          && tolerance >= std::abs( obj.info.x4() - p.x4() )
+           )
+          num  +=  obj.count;
+      BOOST_REQUIRE_EQUAL( octree.countWithin( p, tolerance ), num );
+    }
+}
+
+
+// the thread body of testOctree19: countWithin() of every query:
+static
+void
+countAllWithin( const d7cA::Octree<d7cA::Point, double>&  octree,
+                const std::vector<d7cA::Point<double> >&  vecQueries,
+                std::vector<std::size_t>&                 vecCounts
+              )
+{
+  for ( const d7cA::Point<double>&  p : vecQueries )
+    vecCounts.push_back( octree.countWithin( p, 2.5 ) );
+}
+
+
+// the cached counts of a tree of the mode M follow the changes
+// of the tree ( testOctree19 ):
+template<bool  M>
+static
+void
+checkCountWithinUpkeep( const std::vector<d7cA::Point<double> >&  vecPoints, const std::vector<d7cA::Point<double> >&  vecQueries )
+{
+  const std::size_t  numPoints  =  vecPoints.size();
+  // a tree built at once, then grown further by insert():
+  d7cA::Octree<d7cA::Point, double, void, M>  octree;
+  std::vector<d7cA::Point<double> >  vecSorted( vecPoints.begin(), vecPoints.begin() + numPoints / 2 );
+  octree.init( vecSorted.data(), numPoints / 2, d7cA::comparePoints<double> );
+  checkCountWithin( octree, vecQueries );
+  BOOST_CHECK_EQUAL( octree.countWithin( vecQueries[ 0 ], -1. ), 0u );
+  BOOST_CHECK_EQUAL( octree.countWithin( vecQueries[ 0 ], 100. ), octree.getNumElements() );
+  for ( std::size_t i = numPoints / 2; i < numPoints; ++i )
+    octree.insert( vecPoints[ i ] );
+  checkCountWithin( octree, vecQueries );
+
+  // the cached counts follow the changes of the tree:
+  d7cA::Octree<d7cA::Point, double, void, M>  upper  =  octree.split( 6 );
+  checkCountWithin( octree, vecQueries );
+  checkCountWithin( upper, vecQueries );
+  octree.merge( std::move( upper ) );
+  checkCountWithin( octree, vecQueries );
+  octree.relayout();
+  checkCountWithin( octree, vecQueries );
+  const d7cA::Octree<d7cA::Point, double, void, M>  moved( std::move( octree ) );
+  checkCountWithin( moved, vecQueries );
+  BOOST_CHECK_EQUAL( octree.countWithin( vecQueries[ 0 ], 100. ), 0u );
+}
+
+
+BOOST_AUTO_TEST_CASE( testOctree19 )
+{
+  constexpr std::size_t  numPoints  =  2000;
+  std::mt19937  gen( 19 );
+  std::uniform_int_distribution<int>  dist( 0, 12 );
+  std::vector<d7cA::Point<double> >  vecPoints;
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    vecPoints.push_back( d7cA::Point<double>( dist( gen ), dist( gen ), dist( gen ), dist( gen ) ) );
+  std::vector<d7cA::Point<double> >  vecQueries;
+  for ( std::size_t i = 0; i < 40; ++i )
+    vecQueries.push_back( d7cA::Point<double>( dist( gen ), dist( gen ), dist( gen ), dist( gen ) ) );
+  vecQueries.push_back( d7cA::Point<double>( -20, 6, 6, 6 ) );
+  vecQueries.push_back( d7cA::Point<double>( 5.5, 6.5, 0.5, 12.5 ) );
+
+  d7cA::Octree<d7cA::Point, double>  empty;
+  BOOST_CHECK_EQUAL( empty.countWithin( vecQueries[ 0 ], 100. ), 0u );
+
+  checkCountWithinUpkeep<false>( vecPoints, vecQueries );
+  checkCountWithinUpkeep<true>( vecPoints, vecQueries );
+
+  // two readers of a tree changed last, both of them find the cache
+  // to be refilled:
+  d7cA::Octree<d7cA::Point, double>  octree;
+  std::vector<d7cA::Point<double> >  vecSorted( vecPoints );
+  octree.init( vecSorted.data(), numPoints, d7cA::comparePoints<double> );
+  for ( unsigned short  iRun = 0; iRun < 20; ++iRun )
+  {
+    octree.insert( vecQueries[ iRun ] );
+    std::vector<std::size_t>  vecCountsA;
+    std::vector<std::size_t>  vecCountsB;
+    std::thread  threadA( countAllWithin, std::cref( octree ), std::cref( vecQueries ), std::ref( vecCountsA ) );
+    std::thread  threadB( countAllWithin, std::cref( octree ), std::cref( vecQueries ), std::ref( vecCountsB ) );
+    threadA.join();
+    threadB.join();
+    checkCountWithin( octree, vecQueries );
+    std::vector<std::size_t>  vecExpected;
+    countAllWithin( octree, vecQueries, vecExpected );
+    BOOST_CHECK( vecExpected == vecCountsA );
+    BOOST_CHECK( vecExpected == vecCountsB );
+  }
+}
+
+
+// the elements of testOctree20 are the digits of their indices,
+// every one of them is visited and holds the payload of its index:
+static
+void
+checkPayloads( const d7cA::Octree<d7cA::Point, double, int>&  octree, const std::vector<int>&  vecPayloads )
+{
+  std::size_t  numVisited  =  0;
+  for ( const d7cA::OctreeObj<d7cA::Point, double, int>&  obj : octree )
+  {
+    const std::size_t  i  =  static_cast<std::size_t>( obj.info.x1() + 10 * obj.info.x2() + 100 * obj.info.x3() + 1000 * obj.info.x4() );
+    BOOST_CHECK_EQUAL( obj.payload, vecPayloads[ i ] );
+    ++numVisited;
+  }
+  BOOST_CHECK_EQUAL( numVisited, vecPayloads.size() );
+}
+
+
+BOOST_AUTO_TEST_CASE( testOctree20 )
+{
+  // neither no payload nor the count of a set takes room in a node:
+  BOOST_CHECK_EQUAL( sizeof( d7cA::OctreeObj<d7cA::Point, double> ),
+                     sizeof( d7cA::Point<double> ) + 8 * sizeof( void * ) );
+  BOOST_CHECK_EQUAL( sizeof( d7cA::OctreeObj<d7cA::Point, double, void, true> ),
+                     sizeof( d7cA::Point<double> ) + 8 * sizeof( void * ) + sizeof( unsigned long ) );
+
+  // distinct points, the payload of a point is three times its index:
+  constexpr long  numPoints  =  2000;
+  std::vector<d7cA::Point<double> >  vecPoints;
+  std::vector<int>  vecPayloads;
+  for ( long i = 0; i < numPoints; ++i )
+  {
+    vecPoints.push_back( d7cA::Point<double>( i % 10, ( i / 10 ) % 10, ( i / 100 ) % 10, i / 1000 ) );
+    vecPayloads.push_back( static_cast<int>( 3 * i ) );
+  }
+  std::mt19937  gen( 20 );
+  std::vector<long>  vecShuffled;
+  for ( long i = 0; i < numPoints; ++i )
+    vecShuffled.push_back( i );
+  std::shuffle( vecShuffled.begin(), vecShuffled.end(), gen );
+  std::vector<d7cA::Point<double> >  vecShuffledPoints;
+  std::vector<int>  vecShuffledPayloads;
+  for ( const long  i : vecShuffled )
+  {
+    vecShuffledPoints.push_back( vecPoints[ i ] );
+    vecShuffledPayloads.push_back( vecPayloads[ i ] );
+  }
+
+  d7cA::Octree<d7cA::Point, double, int>  octree;
+  octree.init( vecShuffledPoints.data(), vecShuffledPayloads.data(), numPoints, d7cA::comparePoints<double> );
+  BOOST_CHECK_EQUAL( octree.getNumElements(), static_cast<unsigned long>( numPoints ) );
+  // the array is not reordered:
+  BOOST_CHECK( vecShuffledPoints[ 0 ] == vecPoints[ vecShuffled[ 0 ] ] );
+  for ( long i = 0; i < numPoints; ++i )
+  {
+    d7cA::NoQueryStats  stats;
+    const d7cA::OctreeObj<d7cA::Point, double, int> * const  pFound  =  octree.find( vecPoints[ i ], stats );
+    BOOST_REQUIRE( nullptr != pFound );
+    BOOST_CHECK_EQUAL( pFound->payload, vecPayloads[ i ] );
+  }
+
+  // the payloads move with the nodes:
+  const d7cA::Octree<d7cA::Point, double, int>  copy  =  octree.clone();
+  octree.relayout();
+  octree.setHashIndex( true );
+  checkPayloads( octree, vecPayloads );
+  checkPayloads( copy, vecPayloads );
+  d7cA::NoQueryStats  stats;
+  BOOST_REQUIRE( nullptr != octree.find( vecPoints[ 7 ], stats ) );
+  BOOST_CHECK_EQUAL( octree.find( vecPoints[ 7 ], stats )->payload, vecPayloads[ 7 ] );
+
+  // insert() returns the node holding the element:
+  d7cA::Octree<d7cA::Point, double, std::string, true>  multiset;
+  d7cA::OctreeObj<d7cA::Point, double, std::string, true> * const  p  =  multiset.insert( vecPoints[ 0 ], std::string( "first" ) );
+  BOOST_REQUIRE( nullptr != p );
+  BOOST_CHECK_EQUAL( p->payload, "first" );
+  multiset.insert( vecPoints[ 1 ], std::string( "second" ) );
+  BOOST_CHECK( p == multiset.insert( vecPoints[ 0 ], std::string( "third" ) ) );
+  BOOST_CHECK_EQUAL( p->count, 2u );
+  BOOST_CHECK_EQUAL( p->payload, "third" );
+  const d7cA::Octree<d7cA::Point, double, std::string, true>  multisetCopy  =  multiset.clone();
+  BOOST_REQUIRE( nullptr != multisetCopy.find( vecPoints[ 1 ], stats ) );
+  BOOST_CHECK_EQUAL( multisetCopy.find( vecPoints[ 1 ], stats )->payload, "second" );
+}
+
+
+BOOST_AUTO_TEST_CASE( testOctree21 )
+{
+  // ten slices of 200 nodes each, the North-South chain is 10 nodes long:
+  constexpr std::size_t  numSlices  =  10;
+  constexpr std::size_t  numPoints  =  2000;
+  std::vector<d7cA::Point<double> >  vecPoints;
+  for ( std::size_t i = 0; i < numPoints; ++i )
+    vecPoints.push_back( d7cA::Point<double>( i % 10, ( i / 10 ) % 10, ( i / 100 ) % 10, i / 1000 ) );
+
+  for ( int  pivot = 0; pivot <= static_cast<int>( numSlices ); ++pivot )
+  {
+    // without an index split() walks the smaller half and the chains only:
+    d7cA::Octree<d7cA::Point, double>  lower;
+    lower.init( vecPoints.data(), numPoints, d7cA::comparePoints<double> );
+    std::size_t  numVisited  =  0;
+    d7cA::Octree<d7cA::Point, double>  upper  =  d7cA::OctreeAccess<SplitCostTest>::split( lower, pivot, numVisited );
+    BOOST_REQUIRE_EQUAL( lower.getNumNodes() + upper.getNumNodes(), numPoints );
+    const std::size_t  numSmaller  =  std::min( lower.getNumNodes(), upper.getNumNodes() );
+    BOOST_CHECK_GE( numVisited, 2 * numSmaller );
+    BOOST_CHECK_LE( numVisited, 2 * numSmaller + 4 * numSlices );
+
+    // an index makes it linear in the size of the tree
+    // ( unless nothing moves, which leaves the index as it is ):
+    d7cA::Octree<d7cA::Point, double>  indexed;
+    indexed.init( vecPoints.data(), numPoints, d7cA::comparePoints<double> );
+    indexed.setHashIndex( true );
+    std::size_t  numVisitedIndexed  =  0;
+    d7cA::OctreeAccess<SplitCostTest>::split( indexed, pivot, numVisitedIndexed );
+    if ( 0 != upper.getNumNodes() )
+      BOOST_CHECK_GE( numVisitedIndexed, numPoints );
+    BOOST_CHECK_LE( numVisitedIndexed, numPoints + 2 * numSmaller + 4 * numSlices );
+  }
+}
+
+BOOST_AUTO_TEST_CASE( testOctree22 )
+{
+  // zig-zag geometries grown by insert(): the signs of the coordinates alternate
+  // while their magnitudes grow, so that the walks keep turning at every level,
+  // plus random points on a small grid, where the nodes get attached off their
+  // chains; every walk over the tree must reach all of its nodes:
+  std::mt19937  gen( 22 );
+  std::uniform_int_distribution<>  dist( -3, +3 );
+  for ( int  iTrial = 0; iTrial < 20; ++iTrial )
+  {
+    d7cA::Octree<d7cA::Point, double>  octree;
+    d7cA::Octree<d7cA::Point, double>  other;
+    for ( int i = 1; i <= 200; ++i )
+    {
+      const int  s  =  ( 0 == i % 2 ) ? i : -i;
+      const int  t  =  ( 0 == ( i / 2 ) % 2 ) ? i : -i;
+      octree.insert( d7cA::Point<double>( s % ( 7 + iTrial ), t, -s, t % ( 3 + iTrial ) ) );
+      other.insert( d7cA::Point<double>( t % 5, -s, t, s % ( 2 + iTrial ) ) );
+      octree.insert( d7cA::Point<double>( dist( gen ), dist( gen ), dist( gen ), dist( gen ) ) );
+      other.insert( d7cA::Point<double>( dist( gen ), dist( gen ), dist( gen ), dist( gen ) ) );
+    }
+    octree.merge( std::move( other ) );
+    d7cA::Octree<d7cA::Point, double>  upper  =  octree.split( 0 );
+    octree.merge( std::move( upper ) );
+
+    std::size_t  numIterated  =  0;
+    for ( const d7cA::OctreeObj<d7cA::Point, double>&  obj : octree )
+    {
+      static_cast<void>( obj );
+      ++numIterated;
+    }
+    BOOST_CHECK_EQUAL( numIterated, octree.getNumNodes() );
+    BOOST_CHECK_EQUAL( octree.stats().numNodes, octree.getNumNodes() );
+    BOOST_CHECK_EQUAL( octree.countWithin( d7cA::Point<double>( 0, 0, 0, 0 ), 1000. ), octree.getNumElements() );
+
+    d7cA::Octree<d7cA::Point, double>  copy  =  octree.clone();
+    BOOST_CHECK_EQUAL( copy.getNumNodes(), octree.getNumNodes() );
+    copy.relayout();
+    BOOST_CHECK_EQUAL( copy.getNumNodes(), octree.getNumNodes() );
+    BOOST_CHECK( std::equal( octree.begin(), octree.end(), copy.begin(),
+                             [] ( const d7cA::OctreeObj<d7cA::Point, double>&  a,
+                                  const d7cA::OctreeObj<d7cA::Point, double>&  b ) { return  a.info == b.info; } ) );
+  }
+}
+
+BOOST_AUTO_TEST_CASE( testOctree23 )
+{
+  // trees built by init(), trees skewed by a distribution of x1 crowded at
+  // its low end, and trees grown by insert() in the sorted and the reverse order,
+  // whose roots stay at the South and the North ends of their chains:
+  std::mt19937  gen( 23 );
+  std::uniform_int_distribution<>  dist( -5, +5 );
+  std::exponential_distribution<>  distSkewed( 0.5 );
+  std::size_t  numSouth  =  0;
+  std::size_t  numNorth  =  0;
+  for ( int  iTrial = 0; iTrial < 10; ++iTrial )
+  {
+    std::vector<d7cA::Point<double> >  vecPoints;
+    std::vector<d7cA::Point<double> >  vecSkewed;
+    for ( int i = 0; i < 500; ++i )
+    {
+      vecPoints.push_back( d7cA::Point<double>( dist( gen ), dist( gen ), dist( gen ), dist( gen ) ) );
+      vecSkewed.push_back( d7cA::Point<double>( std::floor( distSkewed( gen ) ) - 5, dist( gen ), dist( gen ), dist( gen ) ) );
+    }
+
+    d7cA::Octree<d7cA::Point, double>  octree;
+    std::vector<d7cA::Point<double> >  vecInit( vecPoints );
+    octree.init( vecInit.data(), vecInit.size(), d7cA::comparePoints<double> );
+    checkFindAgainstFindIf( octree, vecPoints, gen, numSouth, numNorth );
+
+    d7cA::Octree<d7cA::Point, double>  octreeSkewed;
+    std::vector<d7cA::Point<double> >  vecSkewedInit( vecSkewed );
+    octreeSkewed.init( vecSkewedInit.data(), vecSkewedInit.size(), d7cA::comparePoints<double> );
+    checkFindAgainstFindIf( octreeSkewed, vecSkewed, gen, numSouth, numNorth );
+
+    std::vector<d7cA::Point<double> >  vecSorted( vecPoints );
+    std::sort( vecSorted.begin(), vecSorted.end(), d7cA::comparePoints<double> );
+    d7cA::Octree<d7cA::Point, double>  octreeSorted;
+    for ( const d7cA::Point<double>&  p : vecSorted )
+      octreeSorted.insert( p );
+    checkFindAgainstFindIf( octreeSorted, vecPoints, gen, numSouth, numNorth );
+
+    d7cA::Octree<d7cA::Point, double>  octreeReverse;
+    for ( auto  it = vecSorted.rbegin(); it != vecSorted.rend(); ++it )
+      octreeReverse.insert( *it );
+    checkFindAgainstFindIf( octreeReverse, vecPoints, gen, numSouth, numNorth );
+  }
+  BOOST_CHECK_GT( numSouth, 0u );
+  BOOST_CHECK_GT( numNorth, 0u );
+}
+
 BOOST_AUTO_TEST_SUITE_END()